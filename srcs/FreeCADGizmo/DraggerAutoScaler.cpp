@@ -0,0 +1,139 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerAutoScaler.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:47:10, October 17, 2026
+ */
+#include "DraggerAutoScaler.h"
+
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SoDB.h>
+#include <Inventor/nodes/SoOrthographicCamera.h>
+#include <Inventor/nodes/SoPerspectiveCamera.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "SoFCCSysDragger.h"
+
+namespace Gui
+{
+namespace
+{
+std::unordered_map<SoCamera *, DraggerAutoScaler *> &registry()
+{
+    static std::unordered_map<SoCamera *, DraggerAutoScaler *> scalers;
+    return scalers;
+}
+} // namespace
+
+DraggerAutoScaler *DraggerAutoScaler::get(SoCamera *camera)
+{
+    auto &scalers = registry();
+    auto it = scalers.find(camera);
+    if (it != scalers.end()) {
+        return it->second;
+    }
+    auto scaler = new DraggerAutoScaler(camera);
+    scalers.emplace(camera, scaler);
+    return scaler;
+}
+
+DraggerAutoScaler::DraggerAutoScaler(SoCamera *cameraIn)
+    : camera(cameraIn), cameraSensor(&DraggerAutoScaler::cameraCB, this),
+      idleSensor(&DraggerAutoScaler::idleCB, this)
+{
+    // the scale only depends on the distance for a perspective camera and on
+    // the height for an orthographic one
+    if (camera->isOfType(SoOrthographicCamera::getClassTypeId())) {
+        cameraSensor.attach(
+            &static_cast<SoOrthographicCamera *>(camera)->height);
+    } else {
+        cameraSensor.attach(&camera->position);
+    }
+    cameraSensor.setDeleteCallback(&DraggerAutoScaler::cameraDeletedCB, this);
+}
+
+DraggerAutoScaler::~DraggerAutoScaler()
+{
+    cameraSensor.setDeleteCallback(nullptr, nullptr);
+    cameraSensor.detach();
+    idleSensor.unschedule();
+}
+
+void DraggerAutoScaler::add(SoFCCSysDragger *dragger)
+{
+    if (std::find(draggers.begin(), draggers.end(), dragger) ==
+        draggers.end()) {
+        draggers.push_back(dragger);
+    }
+}
+
+void DraggerAutoScaler::remove(SoFCCSysDragger *dragger)
+{
+    // swap and pop, the order of the draggers does not matter
+    auto it = std::find(draggers.begin(), draggers.end(), dragger);
+    if (it != draggers.end()) {
+        *it = draggers.back();
+        draggers.pop_back();
+    }
+
+    if (draggers.empty()) {
+        if (camera) {
+            registry().erase(camera);
+        }
+        delete this;
+    }
+}
+
+void DraggerAutoScaler::schedule()
+{
+    if (camera && !idleSensor.isScheduled()) {
+        idleSensor.schedule();
+    }
+}
+
+void DraggerAutoScaler::update()
+{
+    if (!camera) {
+        return;
+    }
+
+    ++updates;
+    SbViewVolume viewVolume = camera->getViewVolume();
+    // immediate sensors above the draggers run once at endNotify instead of
+    // after every scale write
+    SoDB::startNotify();
+    for (auto dragger : draggers) {
+        if (dragger->updateAutoScale(viewVolume)) {
+            ++scaleWrites;
+        } else {
+            ++skippedWrites;
+        }
+    }
+    SoDB::endNotify();
+}
+
+void DraggerAutoScaler::cameraCB(void *data, SoSensor *)
+{
+    static_cast<DraggerAutoScaler *>(data)->schedule();
+}
+
+void DraggerAutoScaler::idleCB(void *data, SoSensor *)
+{
+    static_cast<DraggerAutoScaler *>(data)->update();
+}
+
+void DraggerAutoScaler::cameraDeletedCB(void *data, SoSensor *)
+{
+    // the draggers keep their last scale, the scaler lives on until they
+    // unregister
+    auto scaler = static_cast<DraggerAutoScaler *>(data);
+    registry().erase(scaler->camera);
+    scaler->camera = nullptr;
+    scaler->idleSensor.unschedule();
+}
+
+} // namespace Gui
@@ -0,0 +1,64 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerAutoScaler.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:47:10, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/sensors/SoFieldSensor.h>
+#include <Inventor/sensors/SoIdleSensor.h>
+
+#include <cstddef>
+#include <vector>
+
+class SoCamera;
+
+namespace Gui
+{
+class SoFCCSysDragger;
+
+/*! @brief Shared auto scaling of all draggers following one camera.
+ *
+ * A camera move triggers a single sensor instead of one per dragger. The
+ * idle callback reads the view volume once and rescales every registered
+ * dragger from the world matrix it cached while rendering, writing only the
+ * scale factors that changed.
+ */
+class DraggerAutoScaler
+{
+  public:
+    //! the scaler of camera, created on first use.
+    static DraggerAutoScaler *get(SoCamera *camera);
+
+    void add(SoFCCSysDragger *dragger);
+    //! the scaler deletes itself with its last dragger.
+    void remove(SoFCCSysDragger *dragger);
+
+    void schedule();
+    void update();
+
+    SoCamera *getCamera() const { return camera; }
+    size_t getNumDraggers() const { return draggers.size(); }
+
+    size_t updates{0};        //!< passes over all draggers.
+    size_t scaleWrites{0};    //!< draggers whose scale changed.
+    size_t skippedWrites{0};  //!< draggers whose scale was still valid.
+
+  private:
+    explicit DraggerAutoScaler(SoCamera *cameraIn);
+    ~DraggerAutoScaler();
+
+    static void cameraCB(void *data, SoSensor *);
+    static void idleCB(void *data, SoSensor *);
+    static void cameraDeletedCB(void *data, SoSensor *);
+
+    SoCamera *camera;
+    SoFieldSensor cameraSensor;
+    SoIdleSensor idleSensor;
+    std::vector<SoFCCSysDragger *> draggers;
+};
+
+} // namespace Gui
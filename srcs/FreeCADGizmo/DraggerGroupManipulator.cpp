@@ -0,0 +1,189 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerGroupManipulator.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:03:02, October 17, 2026
+ */
+#include "DraggerGroupManipulator.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/nodes/SoTransform.h>
+
+#include "DraggerMotion.h"
+#include "SoFCCSysDragger.h"
+
+namespace Gui
+{
+namespace
+{
+// to = from * delta for every pose, with the translation as a row vector
+// like SbMatrix::multVecMatrix and the rotations composed like
+// SbRotation::operator*
+void transformPoses(const float *x, const float *y, const float *z,
+                    const float *qx, const float *qy, const float *qz,
+                    const float *qw, size_t count, const SbMatrix &delta,
+                    const SbRotation &deltaRotation, float *toX, float *toY,
+                    float *toZ, float *toQx, float *toQy, float *toQz,
+                    float *toQw)
+{
+    const float m00 = delta[0][0], m01 = delta[0][1], m02 = delta[0][2];
+    const float m10 = delta[1][0], m11 = delta[1][1], m12 = delta[1][2];
+    const float m20 = delta[2][0], m21 = delta[2][1], m22 = delta[2][2];
+    const float m30 = delta[3][0], m31 = delta[3][1], m32 = delta[3][2];
+    for (size_t i = 0; i < count; ++i) {
+        toX[i] = x[i] * m00 + y[i] * m10 + z[i] * m20 + m30;
+        toY[i] = x[i] * m01 + y[i] * m11 + z[i] * m21 + m31;
+        toZ[i] = x[i] * m02 + y[i] * m12 + z[i] * m22 + m32;
+    }
+
+    const float *p = deltaRotation.getValue();
+    const float px = p[0], py = p[1], pz = p[2], pw = p[3];
+    for (size_t i = 0; i < count; ++i) {
+        toQw[i] = pw * qw[i] - px * qx[i] - py * qy[i] - pz * qz[i];
+        toQx[i] = pw * qx[i] + px * qw[i] + py * qz[i] - pz * qy[i];
+        toQy[i] = pw * qy[i] + py * qw[i] + pz * qx[i] - px * qz[i];
+        toQz[i] = pw * qz[i] + pz * qw[i] + px * qy[i] - py * qx[i];
+    }
+}
+} // namespace
+
+void DraggerGroupManipulator::Poses::resize(size_t count)
+{
+    for (auto array : {&x, &y, &z, &qx, &qy, &qz, &qw}) {
+        array->resize(count);
+    }
+}
+
+DraggerGroupManipulator::DraggerGroupManipulator(SoFCCSysDragger *draggerIn)
+    : dragger(draggerIn)
+{
+    dragger->ref();
+    dragger->addStartCallback(&DraggerGroupManipulator::startCB, this);
+    dragger->addValueChangedCallback(
+        &DraggerGroupManipulator::valueChangedCB, this);
+    dragger->addFinishCallback(&DraggerGroupManipulator::finishCB, this);
+}
+
+DraggerGroupManipulator::~DraggerGroupManipulator()
+{
+    dragger->removeStartCallback(&DraggerGroupManipulator::startCB, this);
+    dragger->removeValueChangedCallback(
+        &DraggerGroupManipulator::valueChangedCB, this);
+    dragger->removeFinishCallback(&DraggerGroupManipulator::finishCB, this);
+    dragger->unref();
+
+    active = false;
+    setTargets({});
+    setNotificationRoot(nullptr);
+}
+
+void DraggerGroupManipulator::setTargets(
+    const std::vector<SoTransform *> &targetsIn)
+{
+    if (active) {
+        return;
+    }
+    for (auto target : targetsIn) {
+        target->ref();
+    }
+    for (auto target : targets) {
+        target->unref();
+    }
+    targets = targetsIn;
+}
+
+void DraggerGroupManipulator::setNotificationRoot(SoNode *root)
+{
+    if (root) {
+        root->ref();
+    }
+    if (notificationRoot) {
+        notificationRoot->unref();
+    }
+    notificationRoot = root;
+}
+
+void DraggerGroupManipulator::begin()
+{
+    size_t count = targets.size();
+    startPoses.resize(count);
+    poses.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const SbVec3f &t = targets[i]->translation.getValue();
+        const float *q = targets[i]->rotation.getValue().getValue();
+        startPoses.x[i] = t[0];
+        startPoses.y[i] = t[1];
+        startPoses.z[i] = t[2];
+        startPoses.qx[i] = q[0];
+        startPoses.qy[i] = q[1];
+        startPoses.qz[i] = q[2];
+        startPoses.qw[i] = q[3];
+    }
+    startInverse = dragger->getMotionMatrix().inverse();
+    active = true;
+}
+
+void DraggerGroupManipulator::update()
+{
+    if (!active || targets.empty()) {
+        return;
+    }
+    ++updates;
+
+    // the motion since the start, applied after each start pose. Always
+    // starting over from the captured poses keeps rounding from piling up.
+    SbMatrix delta = startInverse;
+    delta.multRight(dragger->getMotionMatrix());
+    SbRotation deltaRotation = getMotionRotation(delta);
+
+    size_t count = targets.size();
+    transformPoses(startPoses.x.data(), startPoses.y.data(),
+                   startPoses.z.data(), startPoses.qx.data(),
+                   startPoses.qy.data(), startPoses.qz.data(),
+                   startPoses.qw.data(), count, delta, deltaRotation,
+                   poses.x.data(), poses.y.data(), poses.z.data(),
+                   poses.qx.data(), poses.qy.data(), poses.qz.data(),
+                   poses.qw.data());
+
+    SoDB::startNotify();
+    for (size_t i = 0; i < count; ++i) {
+        SoTransform *target = targets[i];
+        SbBool translationNotify = target->translation.enableNotify(FALSE);
+        SbBool rotationNotify = target->rotation.enableNotify(FALSE);
+        target->translation.setValue(poses.x[i], poses.y[i], poses.z[i]);
+        target->rotation.setValue(poses.qx[i], poses.qy[i], poses.qz[i],
+                                  poses.qw[i]);
+        target->translation.enableNotify(translationNotify);
+        target->rotation.enableNotify(rotationNotify);
+        if (!notificationRoot) {
+            target->touch();
+            ++touches;
+        }
+    }
+    if (notificationRoot) {
+        notificationRoot->touch();
+        ++touches;
+    }
+    SoDB::endNotify();
+}
+
+void DraggerGroupManipulator::end() { active = false; }
+
+void DraggerGroupManipulator::startCB(void *data, SoDragger *)
+{
+    static_cast<DraggerGroupManipulator *>(data)->begin();
+}
+
+void DraggerGroupManipulator::valueChangedCB(void *data, SoDragger *)
+{
+    static_cast<DraggerGroupManipulator *>(data)->update();
+}
+
+void DraggerGroupManipulator::finishCB(void *data, SoDragger *)
+{
+    static_cast<DraggerGroupManipulator *>(data)->end();
+}
+
+} // namespace Gui
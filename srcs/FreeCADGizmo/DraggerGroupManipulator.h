@@ -0,0 +1,82 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerGroupManipulator.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:03:02, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/SbMatrix.h>
+
+#include <cstddef>
+#include <vector>
+
+class SoDragger;
+class SoNode;
+class SoTransform;
+
+namespace Gui
+{
+class SoFCCSysDragger;
+
+/*! @brief One SoFCCSysDragger moving many SoTransform nodes.
+ *
+ * On drag start the translation and rotation of every target are copied
+ * into flat arrays. Every motion of the dragger then applies the change of
+ * its motion matrix since the start to all of them in one pass over the
+ * arrays, and writes the fields back without notifying each one. The
+ * targets must live in the same space as the dragger, their center, scale
+ * and scale orientation are left alone.
+ *
+ * Without a notification root every written target is touched once. With
+ * one, only the root is touched for the whole update, which is right as
+ * long as no separator between the root and the targets caches, e.g. when
+ * the targets sit below SoTransformSeparator nodes.
+ */
+class DraggerGroupManipulator
+{
+  public:
+    explicit DraggerGroupManipulator(SoFCCSysDragger *draggerIn);
+    ~DraggerGroupManipulator();
+    DraggerGroupManipulator(const DraggerGroupManipulator &) = delete;
+    DraggerGroupManipulator &
+    operator=(const DraggerGroupManipulator &) = delete;
+
+    //! replaces the selection, ignored while dragging.
+    void setTargets(const std::vector<SoTransform *> &targetsIn);
+    size_t getNumTargets() const { return targets.size(); }
+    void setNotificationRoot(SoNode *root);
+
+    //! called from the dragger callbacks, public for scripted drags.
+    void begin();
+    void update();
+    void end();
+    bool isActive() const { return active; }
+
+    size_t updates{0}; //!< passes over the selection.
+    size_t touches{0}; //!< nodes touched by those passes.
+
+  private:
+    static void startCB(void *data, SoDragger *);
+    static void valueChangedCB(void *data, SoDragger *);
+    static void finishCB(void *data, SoDragger *);
+
+    // structure of arrays, so the update loops vectorize
+    struct Poses {
+        std::vector<float> x, y, z;
+        std::vector<float> qx, qy, qz, qw;
+        void resize(size_t count);
+    };
+
+    SoFCCSysDragger *dragger;
+    SoNode *notificationRoot{nullptr};
+    std::vector<SoTransform *> targets;
+    Poses startPoses;
+    Poses poses;
+    SbMatrix startInverse;
+    bool active{false};
+};
+
+} // namespace Gui
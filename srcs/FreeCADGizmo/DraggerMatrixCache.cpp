@@ -0,0 +1,156 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerMatrixCache.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:49:23, October 17, 2026
+ */
+#include "DraggerMatrixCache.h"
+
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoFullPath.h>
+#include <Inventor/actions/SoGetMatrixAction.h>
+#include <Inventor/draggers/SoDragger.h>
+
+#include <initializer_list>
+
+namespace Gui
+{
+DraggerMatrixCache::Counters DraggerMatrixCache::counters;
+
+DraggerMatrixCache::DraggerMatrixCache(SoDragger *ownerIn)
+    : owner(ownerIn), pathSensor(&DraggerMatrixCache::pathCB, this)
+{
+    // a queued sensor could hand out a stale matrix to the next event
+    pathSensor.setPriority(0);
+}
+
+DraggerMatrixCache::~DraggerMatrixCache() { release(); }
+
+bool DraggerMatrixCache::setParentToWorld(const SbMatrix &matrix)
+{
+    // composed from the motion of the parent dragger during a drag
+    if (parentDragger) {
+        return false;
+    }
+    if (valid && matrix == parentToWorld) {
+        return false;
+    }
+    parentToWorld = matrix;
+    valid = true;
+    return true;
+}
+
+SbMatrix DraggerMatrixCache::getLocalToWorld()
+{
+    ++counters.lookups;
+    if (!valid || unwatched) {
+        ++counters.traversals;
+        SbMatrix localToWorld = owner->getLocalToWorldMatrix();
+        // keep only the part above the dragger, the motion matrix changes on
+        // every drag step
+        parentToWorld = owner->getMotionMatrix().inverse();
+        parentToWorld.multRight(localToWorld);
+
+        if (parentDragger) {
+            // the motion of the parent dragger changes on every step too.
+            // The path up to it ends at a kit, the kit adds nothing itself.
+            SoPath *above = path->copy(0, parentIndex + 1);
+            above->ref();
+            SoGetMatrixAction action(SbViewportRegion(1, 1));
+            action.apply(above);
+            above->unref();
+            parentAbove = action.getMatrix();
+
+            SbMatrix parentToWorldAtMotion = parentDragger->getMotionMatrix();
+            parentToWorldAtMotion.multRight(parentAbove);
+            parentMotionToOwner = parentToWorld;
+            parentMotionToOwner.multRight(parentToWorldAtMotion.inverse());
+        }
+        // an unwatched matrix could go stale unnoticed
+        valid = !unwatched;
+        return localToWorld;
+    }
+
+    if (parentDragger) {
+        parentToWorld = parentMotionToOwner;
+        parentToWorld.multRight(parentDragger->getMotionMatrix());
+        parentToWorld.multRight(parentAbove);
+    }
+    SbMatrix localToWorld = owner->getMotionMatrix();
+    localToWorld.multRight(parentToWorld);
+    return localToWorld;
+}
+
+void DraggerMatrixCache::watch(const SoPath *pickPath)
+{
+    release();
+    // the matrix of the last render may be stale, batched gizmo rendering
+    // and render caches above the dragger skip its GLRender. Every drag
+    // starts with one traversal, the path sensor keeps the result valid.
+    valid = false;
+    int index = pickPath ? pickPath->findNode(owner) : -1;
+    if (index < 0) {
+        // nothing to watch, a traversal per lookup until release
+        unwatched = true;
+        return;
+    }
+
+    // the path references its nodes, so it is only held during a drag
+    path = pickPath->copy(0, index + 1);
+    path->ref();
+    pathSensor.attach(path);
+
+    auto fullPath = reinterpret_cast<const SoFullPath *>(path);
+    for (int i = index - 1; i >= 0; --i) {
+        SoNode *node = fullPath->getNode(i);
+        if (node->isOfType(SoDragger::getClassTypeId())) {
+            parentDragger = static_cast<SoDragger *>(node);
+            parentIndex = i;
+            break;
+        }
+    }
+}
+
+void DraggerMatrixCache::release()
+{
+    unwatched = false;
+    parentDragger = nullptr;
+    parentIndex = -1;
+    if (!path) {
+        return;
+    }
+    pathSensor.detach();
+    path->unref();
+    path = nullptr;
+    // the split matrix is not updated by renders
+    valid = false;
+}
+
+bool DraggerMatrixCache::isOwnMotion(const SoNode *node) const
+{
+    // the draggers notify for their motion, directly or from the motion
+    // matrix part, both are applied on lookup anyway
+    if (!node) {
+        return false;
+    }
+    for (SoDragger *dragger : {owner, parentDragger}) {
+        if (dragger && (node == dragger ||
+                        node == dragger->getPart("motionMatrix", FALSE))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DraggerMatrixCache::pathCB(void *data, SoSensor *sensor)
+{
+    auto cache = static_cast<DraggerMatrixCache *>(data);
+    auto trigger = static_cast<SoPathSensor *>(sensor)->getTriggerNode();
+    if (!cache->isOwnMotion(trigger)) {
+        cache->invalidate();
+    }
+}
+
+} // namespace Gui
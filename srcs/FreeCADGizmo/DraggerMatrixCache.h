@@ -0,0 +1,83 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerMatrixCache.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:49:23, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/SbMatrix.h>
+#include <Inventor/sensors/SoPathSensor.h>
+
+#include <cstddef>
+
+class SoDragger;
+class SoNode;
+class SoPath;
+
+namespace Gui
+{
+
+/*! @brief Local to world matrix of a dragger without path traversals.
+ *
+ * Keeps the matrix above the dragger and composes it with the current
+ * motion matrix on lookup. A drag starts with one path traversal, then a
+ * path sensor on the pick path drops the matrix as soon as a node above the
+ * dragger changes. Renders refresh it too, but they are not relied on as
+ * batched gizmo rendering and render caches skip the GLRender of the child
+ * draggers.
+ *
+ * A child dragger hands its motion to the parent dragger it is registered
+ * with on every drag step. The matrix is split at the motion of the nearest
+ * dragger above on the pick path, which is composed on lookup like the own
+ * one, so those steps keep the matrix. A drag without a pick path through
+ * the dragger walks the path on every lookup.
+ */
+class DraggerMatrixCache
+{
+  public:
+    struct Counters {
+        size_t lookups{0};    //!< matrices asked for.
+        size_t traversals{0}; //!< lookups that had to walk the path.
+    };
+    static Counters counters; //!< summed over all draggers.
+
+    explicit DraggerMatrixCache(SoDragger *ownerIn);
+    ~DraggerMatrixCache();
+    DraggerMatrixCache(const DraggerMatrixCache &) = delete;
+    DraggerMatrixCache &operator=(const DraggerMatrixCache &) = delete;
+
+    //! the model matrix at the dragger, from SoModelMatrixElement. Returns
+    //! false if the cached one was valid and equal.
+    bool setParentToWorld(const SbMatrix &matrix);
+    SbMatrix getLocalToWorld();
+    void invalidate() { valid = false; }
+
+    //! watch the part of pickPath above the dragger until release.
+    void watch(const SoPath *pickPath);
+    void release();
+
+  private:
+    static void pathCB(void *data, SoSensor *sensor);
+
+    bool isOwnMotion(const SoNode *node) const;
+
+    SoDragger *owner;
+    SbMatrix parentToWorld;
+    bool valid{false};
+    SoPathSensor pathSensor;
+    SoPath *path{nullptr};
+    // dragging without a watched path
+    bool unwatched{false};
+
+    // the nearest dragger above on the watched path, its motion is split
+    // out of parentToWorld
+    SoDragger *parentDragger{nullptr};
+    int parentIndex{-1};          // on path
+    SbMatrix parentAbove;         // the model matrix at parentDragger
+    SbMatrix parentMotionToOwner; // from its motion down to the owner
+};
+
+} // namespace Gui
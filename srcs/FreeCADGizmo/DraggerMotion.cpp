@@ -0,0 +1,90 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerMotion.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:01:01, October 17, 2026
+ */
+#include "DraggerMotion.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Gui
+{
+namespace
+{
+bool isAffine(const SbMatrix &motion)
+{
+    return motion[0][3] == 0.0f && motion[1][3] == 0.0f &&
+           motion[2][3] == 0.0f && motion[3][3] == 1.0f;
+}
+
+bool isRigid(const SbMatrix &motion)
+{
+    if (!isAffine(motion)) {
+        return false;
+    }
+    constexpr float tolerance = 1e-5f;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = i; j < 3; ++j) {
+            float dot = motion[i][0] * motion[j][0] +
+                        motion[i][1] * motion[j][1] +
+                        motion[i][2] * motion[j][2];
+            if (std::fabs(dot - (i == j ? 1.0f : 0.0f)) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void decompose(const SbMatrix &motion, SbVec3f &translation,
+               SbRotation &rotation)
+{
+    SbVec3f scaleDummy;
+    SbRotation scaleOrientationDummy;
+    motion.getTransform(translation, rotation, scaleDummy,
+                        scaleOrientationDummy);
+}
+} // namespace
+
+SbVec3f getMotionTranslation(const SbMatrix &motion)
+{
+    if (isAffine(motion)) {
+        return SbVec3f(motion[3][0], motion[3][1], motion[3][2]);
+    }
+
+    SbVec3f translation;
+    SbRotation rotationDummy;
+    decompose(motion, translation, rotationDummy);
+    return translation;
+}
+
+SbRotation getMotionRotation(const SbMatrix &motion)
+{
+    if (isRigid(motion)) {
+        return SbRotation(motion);
+    }
+
+    SbVec3f translationDummy;
+    SbRotation rotation;
+    decompose(motion, translationDummy, rotation);
+    return rotation;
+}
+
+float getRotationError(const SbRotation &a, const SbRotation &b)
+{
+    const float *qa = a.getValue();
+    const float *qb = b.getValue();
+    float dot = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+    float sign = dot < 0.f ? -1.f : 1.f;
+    float error = 0.f;
+    for (int i = 0; i < 4; ++i) {
+        error = std::max(error, std::fabs(qa[i] - sign * qb[i]));
+    }
+    return error;
+}
+
+} // namespace Gui
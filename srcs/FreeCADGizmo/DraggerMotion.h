@@ -0,0 +1,36 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerMotion.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:01:01, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/SbMatrix.h>
+#include <Inventor/SbRotation.h>
+#include <Inventor/SbVec3f.h>
+
+namespace Gui
+{
+
+/*! @brief Parts of a dragger motion matrix without SbMatrix::getTransform.
+ *
+ * The draggers only ever translate and rotate, so the translation is the
+ * last row and the rotation comes straight from the upper 3x3. A matrix
+ * carrying a scale, a shear or a projection still goes through the full
+ * decomposition.
+ */
+SbVec3f getMotionTranslation(const SbMatrix &motion);
+SbRotation getMotionRotation(const SbMatrix &motion);
+
+/*! @brief Largest component difference of the quaternions of a and b.
+ *
+ * q and -q are the same rotation, so b is flipped when the quaternions
+ * point in opposite directions. Used to compare extracted rotations with
+ * the ones SbMatrix::getTransform gives.
+ */
+float getRotationError(const SbRotation &a, const SbRotation &b);
+
+} // namespace Gui
@@ -0,0 +1,62 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerMotionCoalescer.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:59:44, October 17, 2026
+ */
+#include "DraggerMotionCoalescer.h"
+
+namespace Gui
+{
+DraggerMotionCoalescer::Counters DraggerMotionCoalescer::counters;
+
+DraggerMotionCoalescer::DraggerMotionCoalescer(SoDragger *ownerIn,
+                                               ApplyCB applyIn)
+    : owner(ownerIn), applyCB(applyIn),
+      stepSensor(&DraggerMotionCoalescer::stepCB, this)
+{
+}
+
+void DraggerMotionCoalescer::setEnabled(bool on)
+{
+    if (!on) {
+        flush();
+    }
+    enabled = on;
+}
+
+void DraggerMotionCoalescer::motion(const SbVec2f &locator)
+{
+    ++counters.motions;
+    pendingLocator = locator;
+    if (!enabled) {
+        apply();
+        return;
+    }
+    if (!stepSensor.isScheduled()) {
+        stepSensor.schedule();
+    }
+}
+
+void DraggerMotionCoalescer::flush()
+{
+    if (stepSensor.isScheduled()) {
+        stepSensor.unschedule();
+        apply();
+    }
+}
+
+void DraggerMotionCoalescer::stepCB(void *data, SoSensor *)
+{
+    static_cast<DraggerMotionCoalescer *>(data)->apply();
+}
+
+void DraggerMotionCoalescer::apply()
+{
+    ++counters.steps;
+    applyCB(owner, pendingLocator);
+}
+
+} // namespace Gui
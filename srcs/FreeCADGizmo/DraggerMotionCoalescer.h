@@ -0,0 +1,64 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file DraggerMotionCoalescer.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:59:44, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/SbVec2f.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+
+#include <cstddef>
+
+class SoDragger;
+
+namespace Gui
+{
+
+/*! @brief At most one drag step of a dragger per frame.
+ *
+ * While enabled, the motion events of a drag only keep the latest locator
+ * position and the step is applied once from a one shot sensor, which the
+ * viewer processes with the delay queue right before it renders. Unlike an
+ * idle sensor it is never held back by a frame budget for the sensors.
+ * Disabled, every event applies its step at once. A pending step is applied
+ * before the drag finishes.
+ */
+class DraggerMotionCoalescer
+{
+  public:
+    using ApplyCB = void (*)(SoDragger *dragger, const SbVec2f &locator);
+
+    struct Counters {
+        size_t motions{0}; //!< motion events seen.
+        size_t steps{0};   //!< drag steps applied.
+    };
+    static Counters counters; //!< summed over all draggers.
+
+    DraggerMotionCoalescer(SoDragger *ownerIn, ApplyCB applyIn);
+    DraggerMotionCoalescer(const DraggerMotionCoalescer &) = delete;
+    DraggerMotionCoalescer &operator=(const DraggerMotionCoalescer &) = delete;
+
+    void setEnabled(bool on);
+    bool isEnabled() const { return enabled; }
+
+    //! locator is the normalized position of the motion event.
+    void motion(const SbVec2f &locator);
+    //! apply the pending step, if any.
+    void flush();
+
+  private:
+    static void stepCB(void *data, SoSensor *sensor);
+    void apply();
+
+    SoDragger *owner;
+    ApplyCB applyCB;
+    bool enabled{false};
+    SbVec2f pendingLocator;
+    SoOneShotSensor stepSensor;
+};
+
+} // namespace Gui
@@ -0,0 +1,995 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file FreeCADGizmoBenchmark.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:47:10, October 17, 2026
+ */
+#include "DraggerAutoScaler.h"
+#include "DraggerGroupManipulator.h"
+#include "DraggerMatrixCache.h"
+#include "DraggerMotion.h"
+#include "DraggerMotionCoalescer.h"
+#include "So3DAnnotationLayer.h"
+#include "SoFCCSysDragger.h"
+#include "SoFCGizmoShape.h"
+
+#include <CoinApp.h>
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SoDB.h>
+#include <Inventor/actions/SoCallbackAction.h>
+#include <Inventor/actions/SoHandleEventAction.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/events/SoLocation2Event.h>
+#include <Inventor/events/SoMouseButtonEvent.h>
+#include <Inventor/nodes/SoCube.h>
+#include <Inventor/nodes/SoPerspectiveCamera.h>
+#include <Inventor/nodes/SoScale.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoShape.h>
+#include <Inventor/nodes/SoTransform.h>
+#include <Inventor/nodes/SoTransformSeparator.h>
+#include <Inventor/nodes/SoTranslation.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+#include <Inventor/sensors/SoSensorManager.h>
+
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fstream>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// returned by the benchmarks that render when no GL context can be created,
+// ctest reports these runs as skipped instead of passed
+constexpr int SkipReturnCode = 77;
+
+// heap allocations of the whole process, for the per frame counts
+std::atomic<size_t> HeapAllocations{0};
+
+void *operator new(std::size_t size)
+{
+    ++HeapAllocations;
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+struct DraggerScene {
+    SoSeparator *root{nullptr};
+    SoPerspectiveCamera *camera{nullptr};
+    std::vector<Gui::SoFCCSysDragger *> draggers;
+};
+
+DraggerScene CreateDraggerScene(int count)
+{
+    DraggerScene scene;
+    scene.root = new SoSeparator;
+    scene.camera = new SoPerspectiveCamera;
+    scene.root->addChild(scene.camera);
+
+    int columns = std::max(1, int(std::ceil(std::sqrt(double(count)))));
+    for (int i = 0; i < count; ++i) {
+        auto sep = new SoSeparator;
+        auto trans = new SoTranslation;
+        trans->translation.setValue(3.f * (i % columns), 3.f * (i / columns),
+                                    0.f);
+        sep->addChild(trans);
+
+        auto dragger = new Gui::SoFCCSysDragger;
+        dragger->draggerSize = 1.f;
+        sep->addChild(dragger);
+        scene.root->addChild(sep);
+        scene.draggers.push_back(dragger);
+    }
+    return scene;
+}
+
+// current resident set, 0 where it is not known
+size_t ResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.WorkingSetSize;
+#else
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    if (!(statm >> pages >> resident)) {
+        return 0;
+    }
+    return resident * size_t(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// window position of the cone of the x translator of a dragger at the
+// origin, a press there starts a translation drag
+SbVec2s TranslatorConePosition(Gui::SoFCCSysDragger *dragger,
+                               SoCamera *camera, int width, int height)
+{
+    SbVec3f cone;
+    Gui::SoFCGizmoShape::getHandleRotation(Gui::SoFCGizmoShape::TranslationX)
+        .multVec(SbVec3f(0.f, 11.f, 0.f), cone);
+    cone *= dragger->autoScaleResult.getValue();
+    SbVec3f screen;
+    camera->getViewVolume(float(width) / float(height))
+        .projectToScreen(cone, screen);
+    return SbVec2s(short(screen[0] * width), short(screen[1] * height));
+}
+
+// what every dragger did on its own before the shared scaler: a path
+// traversal for the world matrix, the view volume and the scale writes
+void LegacyAutoScale(Gui::SoFCCSysDragger *dragger, SoCamera *camera)
+{
+    SbMatrix localToWorld = dragger->getLocalToWorldMatrix();
+    SbVec3f origin;
+    localToWorld.multVecMatrix(SbVec3f(0.0, 0.0, 0.0), origin);
+
+    float radius = dragger->draggerSize.getValue() / 2.0;
+    float localScale =
+        camera->getViewVolume().getWorldToScreenScale(origin, radius);
+    auto scale = SO_GET_PART(dragger, "scaleNode", SoScale);
+    scale->scaleFactor.setValue(localScale, localScale, localScale);
+    dragger->autoScaleResult.setValue(localScale);
+}
+
+// usage: FreeCADGizmoBenchmark autoscale [count...] [--moves n]
+// rescales count draggers after each camera move, once through the old
+// per-dragger path and once through the shared scaler
+int BenchmarkAutoScale(const std::vector<std::string> &args)
+{
+    std::vector<int> counts;
+    int moves = 200;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--moves" && i + 1 < args.size()) {
+            moves = std::stoi(args[++i]);
+        } else {
+            counts.push_back(std::stoi(args[i]));
+        }
+    }
+    if (counts.empty()) {
+        counts = {1, 100, 1'000};
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    for (int count : counts) {
+        auto scene = CreateDraggerScene(count);
+        app.SetSceneGraph(scene.root);
+        for (auto dragger : scene.draggers) {
+            dragger->setUpAutoScale(scene.camera);
+        }
+
+        // one frame hands the model matrices to the draggers
+        unsigned char pixel[4];
+        if (!app.RenderToBuffer(1, 1, pixel)) {
+            spdlog::warn("offscreen rendering is not available");
+            return SkipReturnCode;
+        }
+        SoDB::getSensorManager()->processDelayQueue(true);
+
+        SbVec3f position = scene.camera->position.getValue();
+        auto move = [&](int i) {
+            float offset = (i % 2 == 0) ? 1.f : -1.f;
+            scene.camera->position.setValue(position +
+                                            SbVec3f(0.f, 0.f, offset));
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < moves; ++i) {
+            move(i);
+            for (auto dragger : scene.draggers) {
+                LegacyAutoScale(dragger, scene.camera);
+            }
+        }
+        std::chrono::duration<double, std::milli> legacy =
+            std::chrono::steady_clock::now() - start;
+
+        auto scaler = Gui::DraggerAutoScaler::get(scene.camera);
+        scaler->updates = scaler->scaleWrites = scaler->skippedWrites = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < moves; ++i) {
+            move(i);
+            SoDB::getSensorManager()->processDelayQueue(true);
+        }
+        std::chrono::duration<double, std::milli> batched =
+            std::chrono::steady_clock::now() - start;
+
+        std::println("autoscale {:>5} draggers: per dragger {:.4f} ms/move, "
+                     "batched {:.4f} ms/move ({} passes, {} writes, {} "
+                     "skipped)",
+                     count, legacy.count() / moves, batched.count() / moves,
+                     scaler->updates, scaler->scaleWrites,
+                     scaler->skippedWrites);
+
+        app.SetSceneGraph(new SoSeparator);
+    }
+    return EXIT_SUCCESS;
+}
+
+// usage: FreeCADGizmoBenchmark matrix [count] [--events n]
+// sends mouse moves over count draggers, then drags the x translator of the
+// first one, and reports how many of the local to world matrices asked for
+// during event handling needed a traversal
+int BenchmarkMatrix(const std::vector<std::string> &args)
+{
+    int count = 100;
+    int events = 1'000;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--events" && i + 1 < args.size()) {
+            events = std::stoi(args[++i]);
+        } else {
+            count = std::stoi(args[i]);
+        }
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    int width = 640;
+    int height = 480;
+    auto scene = CreateDraggerScene(count);
+    scene.root->ref();
+    app.SetSceneGraph(scene.root);
+    std::vector<unsigned char> rgba(4 * size_t(width) * height);
+    if (!app.RenderToBuffer(width, height, rgba.data())) {
+        spdlog::warn("offscreen rendering is not available");
+        return SkipReturnCode;
+    }
+
+    SbViewportRegion viewport(short(width), short(height));
+    SoHandleEventAction action(viewport);
+    SoLocation2Event event;
+    auto &counters = Gui::DraggerMatrixCache::counters;
+    counters = {};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < events; ++i) {
+        event.setPosition(SbVec2s(short(i % width), short(i % height)));
+        action.setEvent(&event);
+        action.apply(scene.root);
+    }
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::println("matrix {} draggers, {} hover events: {:.4f} ms/event, {} "
+                 "lookups, {} traversals, {} avoided",
+                 count, events, elapsed.count() / events, counters.lookups,
+                 counters.traversals, counters.lookups - counters.traversals);
+
+    // every drag step hands the motion of the translator to the coordinate
+    // system dragger above it on the watched path
+    SbVec2s press = TranslatorConePosition(scene.draggers.front(),
+                                           scene.camera, width, height);
+    SoMouseButtonEvent button;
+    button.setButton(SoMouseButtonEvent::BUTTON1);
+    button.setState(SoButtonEvent::DOWN);
+    button.setPosition(press);
+    action.setEvent(&button);
+    action.apply(scene.root);
+
+    counters = {};
+    SbVec2s position = press;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < events; ++i) {
+        position[0] = short(press[0] + i % 200);
+        event.setPosition(position);
+        action.setEvent(&event);
+        action.apply(scene.root);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    button.setState(SoButtonEvent::UP);
+    button.setPosition(position);
+    action.setEvent(&button);
+    action.apply(scene.root);
+
+    if (counters.lookups == 0) {
+        spdlog::warn("the press missed the translator, no drag was measured");
+    }
+    std::println("matrix {} draggers, {} drag events: {:.4f} ms/event, {} "
+                 "lookups, {} traversals, {} avoided",
+                 count, events, elapsed.count() / events, counters.lookups,
+                 counters.traversals, counters.lookups - counters.traversals);
+
+    app.SetSceneGraph(new SoSeparator);
+    scene.root->unref();
+    return EXIT_SUCCESS;
+}
+
+// usage: FreeCADGizmoBenchmark construct [count...]
+// creates count coordinate system draggers at once and reports the time and
+// the resident memory each one costs
+int BenchmarkConstruct(const std::vector<std::string> &args)
+{
+    std::vector<int> counts;
+    for (const auto &arg : args) {
+        counts.push_back(std::stoi(arg));
+    }
+    if (counts.empty()) {
+        counts = {1, 100, 1'000};
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    // the first instance builds the shared parts, keep it out of the numbers
+    auto first = new Gui::SoFCCSysDragger;
+    first->ref();
+    first->unref();
+
+    for (int count : counts) {
+        auto root = new SoSeparator;
+        root->ref();
+
+        size_t before = ResidentBytes();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i) {
+            root->addChild(new Gui::SoFCCSysDragger);
+        }
+        std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+        size_t after = ResidentBytes();
+
+        std::println("construct {:>5} draggers: {:.1f} us/dragger, {:.1f} "
+                     "KiB/dragger",
+                     count, elapsed.count() / count,
+                     (after > before ? after - before : 0) / 1'024.0 / count);
+        root->unref();
+    }
+    return EXIT_SUCCESS;
+}
+
+// shapes a traversal of root would draw
+size_t CountShapes(SoNode *root)
+{
+    size_t shapes = 0;
+    SoCallbackAction action;
+    action.addPreCallback(
+        SoShape::getClassTypeId(),
+        [](void *data, SoCallbackAction *, const SoNode *) {
+            ++*static_cast<size_t *>(data);
+            return SoCallbackAction::CONTINUE;
+        },
+        &shapes);
+    action.apply(root);
+    return shapes;
+}
+
+// usage: FreeCADGizmoBenchmark render [count] [--frames n]
+// renders count draggers offscreen through their catalog parts and through
+// the gizmo shape, and reports the draws and the time per frame
+int BenchmarkRender(const std::vector<std::string> &args)
+{
+    int count = 100;
+    int frames = 100;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--frames" && i + 1 < args.size()) {
+            frames = std::stoi(args[++i]);
+        } else {
+            count = std::stoi(args[i]);
+        }
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    auto scene = CreateDraggerScene(count);
+    app.SetSceneGraph(scene.root);
+    for (auto dragger : scene.draggers) {
+        dragger->setUpAutoScale(scene.camera);
+    }
+
+    int width = 1'280;
+    int height = 720;
+    std::vector<unsigned char> rgba(4 * size_t(width) * height);
+    for (bool batched : {false, true}) {
+        for (auto dragger : scene.draggers) {
+            dragger->setBatchedRendering(batched);
+        }
+        // warm up, the first frame builds the caches
+        if (!app.RenderToBuffer(width, height, rgba.data())) {
+            spdlog::warn("offscreen rendering is not available");
+            return SkipReturnCode;
+        }
+
+        size_t drawCalls = Gui::SoFCGizmoShape::drawCalls;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; ++i) {
+            app.RenderToBuffer(width, height, rgba.data());
+        }
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        size_t draws = batched ? (Gui::SoFCGizmoShape::drawCalls - drawCalls) /
+                                     frames
+                               : CountShapes(scene.root);
+        std::println("render {} draggers {}: {} draws/frame, {:.3f} ms/frame",
+                     count, batched ? "gizmo shape" : "catalog", draws,
+                     elapsed.count() / frames);
+    }
+    return EXIT_SUCCESS;
+}
+
+// usage: FreeCADGizmoBenchmark pick [count] [--picks n]
+// picks over a grid of screen points through the catalog geometry and
+// through the analytic handle tests, and reports the time per pick and how
+// many of the points hit a handle
+int BenchmarkPick(const std::vector<std::string> &args)
+{
+    int count = 100;
+    int picks = 1'000;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--picks" && i + 1 < args.size()) {
+            picks = std::stoi(args[++i]);
+        } else {
+            count = std::stoi(args[i]);
+        }
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    auto scene = CreateDraggerScene(count);
+    scene.root->ref();
+    app.SetSceneGraph(scene.root);
+    for (auto dragger : scene.draggers) {
+        dragger->setUpAutoScale(scene.camera);
+    }
+    int width = 640;
+    int height = 480;
+    std::vector<unsigned char> rgba(4 * size_t(width) * height);
+    if (!app.RenderToBuffer(width, height, rgba.data())) {
+        spdlog::warn("offscreen rendering is not available");
+        return SkipReturnCode;
+    }
+
+    SbViewportRegion viewport(short(width), short(height));
+    SoRayPickAction action(viewport);
+    for (bool analytic : {false, true}) {
+        for (auto dragger : scene.draggers) {
+            dragger->setAnalyticPicking(analytic);
+        }
+
+        int hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < picks; ++i) {
+            // a coprime stride walks the whole viewport
+            int pixel = int((i * 7'919LL) % (width * height));
+            action.setPoint(SbVec2s(short(pixel % width),
+                                    short(pixel / width)));
+            action.apply(scene.root);
+            if (action.getPickedPoint()) {
+                ++hits;
+            }
+        }
+        std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        std::println("pick {} draggers {}: {:.2f} us/pick, {} of {} hit",
+                     count, analytic ? "analytic" : "catalog",
+                     elapsed.count() / picks, hits, picks);
+    }
+
+    app.SetSceneGraph(new SoSeparator);
+    scene.root->unref();
+    return EXIT_SUCCESS;
+}
+
+// usage: FreeCADGizmoBenchmark drag [events per frame] [--frames n]
+// replays the same drag of the x translator with every event applied at
+// once and with the steps coalesced per frame, and reports the CPU time the
+// events take, the drag steps and the time from the first event of a frame
+// until that frame is rendered
+int BenchmarkDrag(const std::vector<std::string> &args)
+{
+    int eventsPerFrame = 8;
+    int frames = 100;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--frames" && i + 1 < args.size()) {
+            frames = std::stoi(args[++i]);
+        } else {
+            eventsPerFrame = std::stoi(args[i]);
+        }
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    auto scene = CreateDraggerScene(1);
+    scene.root->ref();
+    app.SetSceneGraph(scene.root);
+    auto dragger = scene.draggers.front();
+    dragger->setUpAutoScale(scene.camera);
+
+    int width = 640;
+    int height = 480;
+    std::vector<unsigned char> rgba(4 * size_t(width) * height);
+    if (!app.RenderToBuffer(width, height, rgba.data())) {
+        spdlog::warn("offscreen rendering is not available");
+        return SkipReturnCode;
+    }
+
+    SbVec2s press =
+        TranslatorConePosition(dragger, scene.camera, width, height);
+
+    SbViewportRegion viewport(short(width), short(height));
+    SoHandleEventAction action(viewport);
+    SoMouseButtonEvent button;
+    button.setButton(SoMouseButtonEvent::BUTTON1);
+    SoLocation2Event motion;
+    auto &counters = Gui::DraggerMotionCoalescer::counters;
+
+    for (bool coalesced : {false, true}) {
+        dragger->setCoalescedMotion(coalesced);
+        dragger->translation = SbVec3f(0.f, 0.f, 0.f);
+        app.RenderToBuffer(width, height, rgba.data());
+
+        button.setState(SoButtonEvent::DOWN);
+        button.setPosition(press);
+        action.setEvent(&button);
+        action.apply(scene.root);
+
+        counters = {};
+        std::chrono::duration<double, std::milli> eventTime{0};
+        std::chrono::duration<double, std::milli> latency{0};
+        SbVec2s position = press;
+        for (int f = 0; f < frames; ++f) {
+            auto first = std::chrono::steady_clock::now();
+            for (int e = 0; e < eventsPerFrame; ++e) {
+                position[0] = short(position[0] + 1);
+                motion.setPosition(position);
+                action.setEvent(&motion);
+                action.apply(scene.root);
+            }
+            eventTime += std::chrono::steady_clock::now() - first;
+            app.RenderToBuffer(width, height, rgba.data());
+            latency += std::chrono::steady_clock::now() - first;
+        }
+
+        button.setState(SoButtonEvent::UP);
+        button.setPosition(position);
+        action.setEvent(&button);
+        action.apply(scene.root);
+
+        const SbVec3f &moved = dragger->translation.getValue();
+        std::println("drag {} events/frame {}: {:.4f} ms events/frame, {:.2f} "
+                     "steps/frame, {:.3f} ms event to frame, moved to "
+                     "({:.4f}, {:.4f}, {:.4f})",
+                     eventsPerFrame, coalesced ? "coalesced" : "immediate",
+                     eventTime.count() / frames,
+                     double(counters.steps) / frames,
+                     latency.count() / frames, moved[0], moved[1], moved[2]);
+    }
+
+    app.SetSceneGraph(new SoSeparator);
+    scene.root->unref();
+    return EXIT_SUCCESS;
+}
+
+// usage: FreeCADGizmoBenchmark propagate [count]
+// extracts the translation and rotation of count random motion matrices
+// through SbMatrix::getTransform and through the dragger value callbacks,
+// checks that both give the same fields and reports the time of each.
+// Fails if a field differs.
+int BenchmarkPropagate(const std::vector<std::string> &args)
+{
+    int count = args.empty() ? 100'000 : std::stoi(args.front());
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::vector<SbMatrix> motions(count);
+    for (auto &motion : motions) {
+        SbVec3f axis(unit(random), unit(random), unit(random));
+        if (axis.normalize() == 0.f) {
+            axis.setValue(0.f, 0.f, 1.f);
+        }
+        motion.setTransform(
+            SbVec3f(unit(random), unit(random), unit(random)) * 100.f,
+            SbRotation(axis, float(M_PI) * unit(random)),
+            SbVec3f(1.f, 1.f, 1.f));
+    }
+
+    std::vector<SbVec3f> translations(count);
+    std::vector<SbRotation> rotations(count);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        SbVec3f scale;
+        SbRotation scaleOrientation;
+        motions[i].getTransform(translations[i], rotations[i], scale,
+                                scaleOrientation);
+    }
+    std::chrono::duration<double, std::nano> decompose =
+        std::chrono::steady_clock::now() - start;
+
+    float translationError = 0.f;
+    float rotationError = 0.f;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        SbVec3f translation = Gui::getMotionTranslation(motions[i]);
+        SbRotation rotation = Gui::getMotionRotation(motions[i]);
+        translationError = std::max(
+            translationError, (translation - translations[i]).length());
+        rotationError = std::max(rotationError,
+                                 Gui::getRotationError(rotation, rotations[i]));
+    }
+    std::chrono::duration<double, std::nano> extract =
+        std::chrono::steady_clock::now() - start;
+
+    // the fields written by the value changed callback of the dragger
+    auto dragger = new Gui::SoFCCSysDragger;
+    dragger->ref();
+    float fieldError = 0.f;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        dragger->setMotionMatrix(motions[i]);
+        fieldError = std::max(
+            {fieldError,
+             (dragger->translation.getValue() - translations[i]).length(),
+             Gui::getRotationError(dragger->rotation.getValue(),
+                                   rotations[i])});
+    }
+    std::chrono::duration<double, std::nano> chain =
+        std::chrono::steady_clock::now() - start;
+    dragger->unref();
+
+    std::println("propagate {} motions: getTransform {:.1f} ns, extraction "
+                 "{:.1f} ns, setMotionMatrix {:.1f} ns",
+                 count, decompose.count() / count, extract.count() / count,
+                 chain.count() / count);
+    std::println("propagate max error: translation {:.3g}, rotation {:.3g}, "
+                 "dragger fields {:.3g}",
+                 translationError, rotationError, fieldError);
+
+    constexpr float tolerance = 1e-5f;
+    if (translationError > tolerance || rotationError > tolerance ||
+        fieldError > tolerance) {
+        spdlog::error("the extracted motion differs from getTransform");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// usage: FreeCADGizmoBenchmark group [count...] [--steps n]
+// drags count transforms with one dragger, once by composing and writing
+// every transform on its own and once through DraggerGroupManipulator, and
+// reports the time per drag step and the notifications reaching the root
+int BenchmarkGroup(const std::vector<std::string> &args)
+{
+    std::vector<int> counts;
+    int steps = 100;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--steps" && i + 1 < args.size()) {
+            steps = std::stoi(args[++i]);
+        } else {
+            counts.push_back(std::stoi(args[i]));
+        }
+    }
+    if (counts.empty()) {
+        counts = {100, 1'000, 10'000};
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    auto stepMotion = [](int step) {
+        SbMatrix motion;
+        motion.setTransform(SbVec3f(0.01f * step, 0.f, 0.f),
+                            SbRotation(SbVec3f(0.f, 0.f, 1.f), 0.001f * step),
+                            SbVec3f(1.f, 1.f, 1.f));
+        return motion;
+    };
+
+    for (int count : counts) {
+        auto root = new SoSeparator;
+        root->ref();
+        auto dragger = new Gui::SoFCCSysDragger;
+        root->addChild(dragger);
+        auto selection = new SoSeparator;
+        root->addChild(selection);
+
+        std::vector<SoTransform *> targets;
+        std::vector<SbVec3f> startTranslations;
+        int columns = std::max(1, int(std::ceil(std::sqrt(double(count)))));
+        for (int i = 0; i < count; ++i) {
+            auto part = new SoTransformSeparator;
+            auto transform = new SoTransform;
+            startTranslations.emplace_back(2.f * (i % columns),
+                                           2.f * (i / columns), 0.f);
+            transform->translation = startTranslations.back();
+            part->addChild(transform);
+            part->addChild(new SoCube);
+            selection->addChild(part);
+            targets.push_back(transform);
+        }
+        auto reset = [&] {
+            dragger->setMotionMatrix(SbMatrix::identity());
+            for (int i = 0; i < count; ++i) {
+                targets[i]->translation = startTranslations[i];
+                targets[i]->rotation = SbRotation::identity();
+            }
+        };
+
+        size_t notifications = 0;
+        SoNodeSensor rootSensor(
+            [](void *data, SoSensor *) { ++*static_cast<size_t *>(data); },
+            &notifications);
+        rootSensor.setPriority(0);
+        rootSensor.attach(root);
+
+        // every transform composed and written on its own
+        reset();
+        std::vector<SbVec3f> legacyTranslations(count);
+        notifications = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 1; step <= steps; ++step) {
+            SbMatrix delta = stepMotion(step);
+            dragger->setMotionMatrix(delta);
+            for (int i = 0; i < count; ++i) {
+                SbMatrix matrix;
+                matrix.setTransform(startTranslations[i],
+                                    SbRotation::identity(),
+                                    SbVec3f(1.f, 1.f, 1.f));
+                matrix.multRight(delta);
+                SbVec3f translation, scale;
+                SbRotation rotation, scaleOrientation;
+                matrix.getTransform(translation, rotation, scale,
+                                    scaleOrientation);
+                targets[i]->translation = translation;
+                targets[i]->rotation = rotation;
+                legacyTranslations[i] = translation;
+            }
+        }
+        std::chrono::duration<double, std::milli> legacy =
+            std::chrono::steady_clock::now() - start;
+        size_t legacyNotifications = notifications;
+
+        reset();
+        Gui::DraggerGroupManipulator manipulator(dragger);
+        manipulator.setTargets(targets);
+        manipulator.setNotificationRoot(selection);
+        notifications = 0;
+        start = std::chrono::steady_clock::now();
+        manipulator.begin();
+        for (int step = 1; step <= steps; ++step) {
+            dragger->setMotionMatrix(stepMotion(step));
+        }
+        manipulator.end();
+        std::chrono::duration<double, std::milli> grouped =
+            std::chrono::steady_clock::now() - start;
+
+        float error = 0.f;
+        for (int i = 0; i < count; ++i) {
+            error = std::max(error, (targets[i]->translation.getValue() -
+                                     legacyTranslations[i])
+                                        .length());
+        }
+        std::println("group {:>5} transforms: per transform {:.3f} ms/step "
+                     "({} root notifications), grouped {:.3f} ms/step ({} "
+                     "root notifications), max difference {:.3g}",
+                     count, legacy.count() / steps, legacyNotifications,
+                     grouped.count() / steps, notifications, error);
+
+        rootSensor.detach();
+        manipulator.setTargets({});
+        root->unref();
+    }
+    return EXIT_SUCCESS;
+}
+
+// count annotated cubes in a grid below root
+void AddAnnotations(SoGroup *root, int count)
+{
+    int columns = std::max(1, int(std::ceil(std::sqrt(double(count)))));
+    for (int i = 0; i < count; ++i) {
+        auto annotation = new Gui::So3DAnnotation;
+        auto trans = new SoTranslation;
+        trans->translation.setValue(3.f * (i % columns), 3.f * (i / columns),
+                                    0.f);
+        annotation->addChild(trans);
+        annotation->addChild(new SoCube);
+        root->addChild(annotation);
+    }
+}
+
+// usage: FreeCADGizmoBenchmark annotations [count...] [--frames n]
+// renders count 3D annotations offscreen on their own and below one
+// So3DAnnotationLayer, and reports the depth clears and the time per frame
+int BenchmarkAnnotations(const std::vector<std::string> &args)
+{
+    std::vector<int> counts;
+    int frames = 100;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--frames" && i + 1 < args.size()) {
+            frames = std::stoi(args[++i]);
+        } else {
+            counts.push_back(std::stoi(args[i]));
+        }
+    }
+    if (counts.empty()) {
+        counts = {10, 100, 1'000};
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::So3DAnnotation::initClass();
+
+    int width = 1'280;
+    int height = 720;
+    std::vector<unsigned char> rgba(4 * size_t(width) * height);
+    for (int count : counts) {
+        for (bool layered : {false, true}) {
+            SoSeparator *root = new SoSeparator;
+            auto layer = new Gui::So3DAnnotationLayer;
+            root->addChild(layer);
+            AddAnnotations(layered ? static_cast<SoGroup *>(layer) : root,
+                           count);
+            app.SetSceneGraph(root);
+
+            // warm up, the first frame builds the caches
+            if (!app.RenderToBuffer(width, height, rgba.data())) {
+                spdlog::warn("offscreen rendering is not available");
+                return SkipReturnCode;
+            }
+
+            size_t clears = Gui::So3DAnnotation::depthClears;
+            layer->depthClears = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < frames; ++i) {
+                app.RenderToBuffer(width, height, rgba.data());
+            }
+            std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+            clears = Gui::So3DAnnotation::depthClears - clears +
+                     layer->depthClears;
+
+            std::println("annotations {:>5} {}: {} depth clears/frame, "
+                         "{:.3f} ms/frame",
+                         count, layered ? "layer" : "single",
+                         clears / frames, elapsed.count() / frames);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+// usage: FreeCADGizmoBenchmark delayed [count] [--frames n]
+// renders count draggers drawn from delayed paths, queued as path copies
+// and as the paths a So3DAnnotationLayer keeps and refills, and reports
+// the paths and heap allocations and the time per frame
+int BenchmarkDelayed(const std::vector<std::string> &args)
+{
+    int count = 500;
+    int frames = 100;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--frames" && i + 1 < args.size()) {
+            frames = std::stoi(args[++i]);
+        } else {
+            count = std::stoi(args[i]);
+        }
+    }
+
+    zen::CoinApp app("FreeCADGizmoBenchmark", zen::Backend::Offscreen);
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    int width = 1'280;
+    int height = 720;
+    std::vector<unsigned char> rgba(4 * size_t(width) * height);
+    for (bool layered : {false, true}) {
+        auto scene = CreateDraggerScene(count);
+        auto layer = new Gui::So3DAnnotationLayer;
+        if (layered) {
+            layer->addChild(scene.root);
+            app.SetSceneGraph(layer);
+        } else {
+            layer->ref();
+            app.SetSceneGraph(scene.root);
+        }
+        for (auto dragger : scene.draggers) {
+            dragger->setUpAutoScale(scene.camera);
+        }
+
+        // warm up, the first frames build the caches and the paths
+        for (int i = 0; i < 2; ++i) {
+            if (!app.RenderToBuffer(width, height, rgba.data())) {
+                spdlog::warn("offscreen rendering is not available");
+                return SkipReturnCode;
+            }
+        }
+
+        size_t copies = Gui::So3DAnnotation::pathCopies;
+        size_t paths = layer->pathAllocations;
+        size_t allocations = HeapAllocations;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; ++i) {
+            app.RenderToBuffer(width, height, rgba.data());
+        }
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        paths = Gui::So3DAnnotation::pathCopies - copies +
+                layer->pathAllocations - paths;
+        allocations = HeapAllocations - allocations;
+
+        std::println("delayed {} draggers {}: {:.1f} paths/frame, {:.1f} "
+                     "allocations/frame, {:.3f} ms/frame",
+                     count, layered ? "layer" : "path copies",
+                     double(paths) / frames, double(allocations) / frames,
+                     elapsed.count() / frames);
+
+        app.SetSceneGraph(new SoSeparator);
+        if (!layered) {
+            layer->unref();
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    const std::map<std::string,
+                   std::function<int(const std::vector<std::string> &)>>
+        benchmarks{
+            {"annotations", BenchmarkAnnotations},
+            {"autoscale", BenchmarkAutoScale},
+            {"construct", BenchmarkConstruct},
+            {"delayed", BenchmarkDelayed},
+            {"drag", BenchmarkDrag},
+            {"group", BenchmarkGroup},
+            {"matrix", BenchmarkMatrix},
+            {"pick", BenchmarkPick},
+            {"propagate", BenchmarkPropagate},
+            {"render", BenchmarkRender},
+        };
+
+    std::string name = argc > 1 ? argv[1] : "autoscale";
+    auto it = benchmarks.find(name);
+    if (it == benchmarks.end()) {
+        spdlog::error("unknown benchmark: {}", name);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> args(argv + std::min(argc, 2), argv + argc);
+    try {
+        return it->second(args);
+    } catch (const std::runtime_error &e) {
+        // CoinApp throws when glfw finds no display and no osmesa or egl
+        spdlog::warn("{}", e.what());
+        return SkipReturnCode;
+    }
+}
@@ -1,15 +1,24 @@
+#include "DraggerGroupManipulator.h"
 #include "SoFCCSysDragger.h"
 #include <CoinApp.h>
 #include <Inventor/draggers/SoTransformBoxDragger.h>
+#include <Inventor/nodes/SoCube.h>
 #include <Inventor/nodes/SoCylinder.h>
 #include <Inventor/nodes/SoFont.h>
 #include <Inventor/nodes/SoSeparator.h>
 #include <Inventor/nodes/SoText3.h>
 #include <Inventor/nodes/SoTransform.h>
+#include <Inventor/nodes/SoTransformSeparator.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <memory>
 #include <print>
 #include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
 
 int main(int argc, char **argv) {
   auto src_dir =
@@ -22,6 +31,27 @@ int main(int argc, char **argv) {
   coin_setenv("COIN_FONT_PATH", src_dir_cstr, 1);
   zen::CoinApp app;
 
+  // --record <file> logs the session input, --replay <file> [--fast] plays
+  // it back and reports the frame timings, --parts <n> lets the dragger move
+  // a grid of n parts instead of the text
+  const char *record_file = nullptr;
+  const char *replay_file = nullptr;
+  zen::ReplayOptions replay_options;
+  replay_options.close_when_done = true;
+  int parts = 0;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "--record" && i + 1 < argc) {
+      record_file = argv[++i];
+    } else if (arg == "--replay" && i + 1 < argc) {
+      replay_file = argv[++i];
+    } else if (arg == "--parts" && i + 1 < argc) {
+      parts = std::stoi(argv[++i]);
+    } else if (arg == "--fast") {
+      replay_options.realtime = false;
+    }
+  }
+
   Gui::SoFCCSysDragger::initClass();
   Gui::So3DAnnotation::initClass();
   auto sep = new SoSeparator;
@@ -30,21 +60,53 @@ int main(int argc, char **argv) {
   dragger->draggerSize = 1.f;
   sep->addChild(dragger);
 
-  auto transform = new SoTransform;
-  transform->translation.connectFrom(&dragger->translation);
-  transform->rotation.connectFrom(&dragger->rotation);
-  sep->addChild(transform);
+  // thousands of connected fields would notify one by one, the
+  // manipulator moves the whole selection with one touch per drag step
+  std::unique_ptr<Gui::DraggerGroupManipulator> manipulator;
+  if (parts > 0) {
+    auto selection = new SoSeparator;
+    std::vector<SoTransform *> targets;
+    int columns = std::max(1, int(std::ceil(std::sqrt(double(parts)))));
+    for (int i = 0; i < parts; ++i) {
+      auto part = new SoTransformSeparator;
+      auto transform = new SoTransform;
+      transform->translation.setValue(3.f * (i % columns),
+                                      3.f * (i / columns), 0.f);
+      part->addChild(transform);
+      part->addChild(new SoCube);
+      selection->addChild(part);
+      targets.push_back(transform);
+    }
+    sep->addChild(selection);
+
+    manipulator = std::make_unique<Gui::DraggerGroupManipulator>(dragger);
+    manipulator->setTargets(targets);
+    manipulator->setNotificationRoot(selection);
+  } else {
+    auto transform = new SoTransform;
+    transform->translation.connectFrom(&dragger->translation);
+    transform->rotation.connectFrom(&dragger->rotation);
+    sep->addChild(transform);
 
-  auto font = new SoFont;
-  font->name = "NotoSansSC-Regular.ttf";
-  font->size = 10;
-  auto text = new SoText3;
-  text->string = "Alçapão, Hello, 你好！";
-  text->justification = SoText3::CENTER;
-  sep->addChild(font);
-  sep->addChild(text);
+    auto font = new SoFont;
+    font->name = "NotoSansSC-Regular.ttf";
+    font->size = 10;
+    auto text = new SoText3;
+    text->string = "Alçapão, Hello, 你好！";
+    text->justification = SoText3::CENTER;
+    sep->addChild(font);
+    sep->addChild(text);
+  }
 
   app.SetSceneGraph(sep);
+
+  if (record_file) {
+    app.StartRecording(record_file);
+  }
+  if (replay_file) {
+    app.StartReplay(replay_file, replay_options);
+  }
+
   app.Run();
 
   return 0;
@@ -0,0 +1,169 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file FreeCADGizmoTests.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 14:08:08, October 17, 2026
+ */
+#include "DraggerMotion.h"
+#include "So3DAnnotation.h"
+#include "SoFCCSysDragger.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/SoInteraction.h>
+#include <Inventor/nodekits/SoNodeKit.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// the fields written by the value changed callbacks of the draggers must
+// match what SbMatrix::getTransform gives for the same motion matrix. Runs
+// without a window or a GL context, returns nonzero on a mismatch so ctest
+// fails.
+
+namespace
+{
+constexpr float Tolerance = 1e-5f;
+
+struct Decomposed {
+    SbVec3f translation;
+    SbRotation rotation;
+};
+
+Decomposed Decompose(const SbMatrix &motion)
+{
+    Decomposed result;
+    SbVec3f scale;
+    SbRotation scaleOrientation;
+    motion.getTransform(result.translation, result.rotation, scale,
+                        scaleOrientation);
+    return result;
+}
+
+std::vector<SbMatrix> CreateMotions(int count)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::vector<SbMatrix> motions(count);
+    for (auto &motion : motions) {
+        SbVec3f axis(unit(random), unit(random), unit(random));
+        if (axis.normalize() == 0.f) {
+            axis.setValue(0.f, 0.f, 1.f);
+        }
+        motion.setTransform(
+            SbVec3f(unit(random), unit(random), unit(random)) * 100.f,
+            SbRotation(axis, float(M_PI) * unit(random)),
+            SbVec3f(1.f, 1.f, 1.f));
+    }
+
+    // the fallback to getTransform
+    SbMatrix scaled;
+    scaled.setTransform(SbVec3f(1.f, 2.f, 3.f),
+                        SbRotation(SbVec3f(0.f, 1.f, 0.f), 0.5f),
+                        SbVec3f(2.f, 0.5f, 1.f));
+    motions.push_back(scaled);
+    motions.push_back(SbMatrix::identity());
+    return motions;
+}
+
+bool TestExtraction(const std::vector<SbMatrix> &motions)
+{
+    float translationError = 0.f;
+    float rotationError = 0.f;
+    for (auto &motion : motions) {
+        auto expected = Decompose(motion);
+        translationError =
+            std::max(translationError,
+                     (Gui::getMotionTranslation(motion) - expected.translation)
+                         .length());
+        rotationError =
+            std::max(rotationError,
+                     Gui::getRotationError(Gui::getMotionRotation(motion),
+                                           expected.rotation));
+    }
+
+    if (translationError > Tolerance || rotationError > Tolerance) {
+        spdlog::error("extraction: translation error {:.3g}, rotation error "
+                      "{:.3g}",
+                      translationError, rotationError);
+        return false;
+    }
+    return true;
+}
+
+// Dragger has a translation field
+template <class Dragger>
+bool TestTranslation(const char *name, const std::vector<SbMatrix> &motions)
+{
+    auto dragger = new Dragger;
+    dragger->ref();
+    float error = 0.f;
+    for (auto &motion : motions) {
+        dragger->setMotionMatrix(motion);
+        error = std::max(error, (dragger->translation.getValue() -
+                                 Decompose(motion).translation)
+                                    .length());
+    }
+    dragger->unref();
+
+    if (error > Tolerance) {
+        spdlog::error("{}: translation field error {:.3g}", name, error);
+        return false;
+    }
+    return true;
+}
+
+// Dragger has a rotation field
+template <class Dragger>
+bool TestRotation(const char *name, const std::vector<SbMatrix> &motions)
+{
+    auto dragger = new Dragger;
+    dragger->ref();
+    float error = 0.f;
+    for (auto &motion : motions) {
+        dragger->setMotionMatrix(motion);
+        error = std::max(error,
+                         Gui::getRotationError(dragger->rotation.getValue(),
+                                               Decompose(motion).rotation));
+    }
+    dragger->unref();
+
+    if (error > Tolerance) {
+        spdlog::error("{}: rotation field error {:.3g}", name, error);
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+int main()
+{
+    SoDB::init();
+    SoNodeKit::init();
+    SoInteraction::init();
+    Gui::SoFCCSysDragger::initClass();
+    Gui::So3DAnnotation::initClass();
+
+    auto motions = CreateMotions(1'000);
+
+    bool passed = TestExtraction(motions);
+    passed &= TestTranslation<Gui::TDragger>("TDragger", motions);
+    passed &= TestTranslation<Gui::TPlanarDragger>("TPlanarDragger", motions);
+    passed &= TestRotation<Gui::RDragger>("RDragger", motions);
+    passed &= TestTranslation<Gui::SoFCCSysDragger>("SoFCCSysDragger",
+                                                    motions);
+    passed &= TestRotation<Gui::SoFCCSysDragger>("SoFCCSysDragger", motions);
+
+    if (!passed) {
+        return EXIT_FAILURE;
+    }
+    spdlog::info("dragger fields match getTransform for {} motions",
+                 motions.size());
+    return EXIT_SUCCESS;
+}
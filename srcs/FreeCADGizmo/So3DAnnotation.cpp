@@ -25,11 +25,15 @@
 #include <Inventor/system/gl.h>
 
 #include "So3DAnnotation.h"
+#include "So3DAnnotationLayer.h"
 
 using namespace Gui;
 
 SO_NODE_SOURCE(So3DAnnotation);
 
+size_t So3DAnnotation::depthClears = 0;
+size_t So3DAnnotation::pathCopies = 0;
+
 So3DAnnotation::So3DAnnotation()
 {
     SO_NODE_CONSTRUCTOR(So3DAnnotation);
@@ -38,6 +42,30 @@ So3DAnnotation::So3DAnnotation()
 void So3DAnnotation::initClass()
 {
     SO_NODE_INIT_CLASS(So3DAnnotation, SoSeparator, "3DAnnotation");
+    So3DAnnotationLayer::initClass();
+}
+
+void So3DAnnotation::addDelayedPath(SoGLRenderAction* action)
+{
+    if (auto layer = So3DAnnotationLayer::find(action->getCurPath())) {
+        layer->addAnnotation(action);
+    }
+    else {
+        SoCacheElement::invalidate(action->getState());
+        action->addDelayedPath(action->getCurPath()->copy());
+        ++pathCopies;
+    }
+}
+
+void So3DAnnotation::clearDepth(SoGLRenderAction* action)
+{
+    if (auto layer = So3DAnnotationLayer::find(action->getCurPath())) {
+        layer->clearDepth();
+    }
+    else {
+        glClear(GL_DEPTH_BUFFER_BIT);
+        ++depthClears;
+    }
 }
 
 void So3DAnnotation::GLRender(SoGLRenderAction* action)
@@ -59,24 +87,22 @@ void So3DAnnotation::GLRender(SoGLRenderAction* action)
 void So3DAnnotation::GLRenderBelowPath(SoGLRenderAction* action)
 {
     if (action->isRenderingDelayedPaths()) {
-        glClear(GL_DEPTH_BUFFER_BIT);
+        clearDepth(action);
         inherited::GLRenderBelowPath(action);
     }
     else {
-        SoCacheElement::invalidate(action->getState());
-        action->addDelayedPath(action->getCurPath()->copy());
+        addDelayedPath(action);
     }
 }
 
 void So3DAnnotation::GLRenderInPath(SoGLRenderAction* action)
 {
     if (action->isRenderingDelayedPaths()) {
-        glClear(GL_DEPTH_BUFFER_BIT);
+        clearDepth(action);
         inherited::GLRenderInPath(action);
     }
     else {
-        SoCacheElement::invalidate(action->getState());
-        action->addDelayedPath(action->getCurPath()->copy());
+        addDelayedPath(action);
     }
 }
 
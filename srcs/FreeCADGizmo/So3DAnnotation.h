@@ -23,6 +23,8 @@
 
 #include <Inventor/actions/SoGLRenderAction.h>
 #include <Inventor/nodes/SoSeparator.h>
+
+#include <cstddef>
 // #include <FCGlobal.h>
 
 namespace Gui {
@@ -34,7 +36,9 @@ namespace Gui {
  * everything with proper depth control.
  *
  * It should be used with caution as it does clear the depth buffer for each
- * annotation!
+ * annotation! Below a So3DAnnotationLayer the buffer is cleared once per
+ * frame for all of them, and the annotations keep the render caches of
+ * their separators.
  */
 class So3DAnnotation : public SoSeparator {
   typedef SoSeparator inherited;
@@ -50,6 +54,16 @@ public:
   virtual void GLRenderInPath(SoGLRenderAction *action);
   virtual void GLRenderOffPath(SoGLRenderAction *action);
 
+  /// queues the current path of action for the delayed paths. Below a
+  /// So3DAnnotationLayer the layer keeps it, otherwise it is copied and the
+  /// caches around it are invalidated.
+  static void addDelayedPath(SoGLRenderAction *action);
+  /// clears the depth buffer for an annotation drawn from a delayed path,
+  /// once per frame below a So3DAnnotationLayer
+  static void clearDepth(SoGLRenderAction *action);
+  static size_t depthClears; ///< glClear calls outside of a layer
+  static size_t pathCopies;  ///< delayed paths copied outside of a layer
+
 protected:
   virtual ~So3DAnnotation() = default;
 };
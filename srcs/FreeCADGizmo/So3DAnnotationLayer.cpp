@@ -0,0 +1,215 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file So3DAnnotationLayer.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:05:00, October 17, 2026
+ */
+#include "So3DAnnotationLayer.h"
+
+#include <Inventor/SoFullPath.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/elements/SoCacheElement.h>
+#include <Inventor/misc/SoChildList.h>
+#include <Inventor/misc/SoTempPath.h>
+#include <Inventor/system/gl.h>
+
+#include <algorithm>
+
+using namespace Gui;
+
+namespace
+{
+const SoFullPath *full(const SoPath *path)
+{
+    return reinterpret_cast<const SoFullPath *>(path);
+}
+
+// path from node index start on equals subPath
+bool endsWith(const SoFullPath *path, int start, const SoFullPath *subPath)
+{
+    if (path->getLength() - start != subPath->getLength()) {
+        return false;
+    }
+    for (int i = 0; i < subPath->getLength(); ++i) {
+        if (path->getNode(start + i) != subPath->getNode(i) ||
+            (i > 0 && path->getIndex(start + i) != subPath->getIndex(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+SO_NODE_SOURCE(So3DAnnotationLayer)
+
+std::vector<So3DAnnotationLayer *> So3DAnnotationLayer::layers;
+
+void So3DAnnotationLayer::initClass()
+{
+    SO_NODE_INIT_CLASS(So3DAnnotationLayer, SoSeparator, "Separator");
+}
+
+So3DAnnotationLayer::So3DAnnotationLayer()
+{
+    SO_NODE_CONSTRUCTOR(So3DAnnotationLayer);
+    renderCaching = OFF;
+    layers.push_back(this);
+}
+
+So3DAnnotationLayer::~So3DAnnotationLayer()
+{
+    for (auto &[tail, annotation] : annotations) {
+        release(annotation);
+    }
+    layers.erase(std::find(layers.begin(), layers.end(), this));
+}
+
+So3DAnnotationLayer *So3DAnnotationLayer::find(const SoPath *path)
+{
+    if (!path) {
+        return nullptr;
+    }
+    // the annotations of a dragger are hidden kit parts
+    auto fullPath = full(path);
+    for (int i = fullPath->getLength() - 1; i >= 0; --i) {
+        SoNode *node = fullPath->getNode(i);
+        if (node->isOfType(getClassTypeId())) {
+            return static_cast<So3DAnnotationLayer *>(node);
+        }
+    }
+    return nullptr;
+}
+
+void So3DAnnotationLayer::clearDepth()
+{
+    if (!depthCleared) {
+        glClear(GL_DEPTH_BUFFER_BIT);
+        depthCleared = true;
+        ++depthClears;
+    }
+}
+
+void So3DAnnotationLayer::addAnnotation(SoGLRenderAction *action)
+{
+    auto path = full(action->getCurPath());
+    int start = path->findNode(this) + 1;
+    if (start <= 0 || start >= path->getLength()) {
+        return;
+    }
+
+    const SoNode *tail = path->getTail();
+    auto range = annotations.equal_range(tail);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (endsWith(path, start, full(it->second.subPath))) {
+            return;
+        }
+    }
+
+    Annotation annotation;
+    annotation.subPath = path->copy(start);
+    annotation.subPath->ref();
+    annotation.fullPath = new SoTempPath(path->getLength());
+    annotation.fullPath->ref();
+    annotation.childIndex = path->getIndex(start);
+    annotations.emplace(tail, annotation);
+    pathAllocations += 2;
+}
+
+void So3DAnnotationLayer::removeAnnotations(const SoNode *tail)
+{
+    for (auto layer : layers) {
+        auto range = layer->annotations.equal_range(tail);
+        for (auto it = range.first; it != range.second; ++it) {
+            release(it->second);
+        }
+        layer->annotations.erase(range.first, range.second);
+    }
+}
+
+void So3DAnnotationLayer::release(Annotation &annotation)
+{
+    annotation.subPath->unref();
+    annotation.fullPath->unref();
+}
+
+void So3DAnnotationLayer::GLRender(SoGLRenderAction *action)
+{
+    // the annotations are drawn from the delayed paths, after the scene
+    if (action->isRenderingDelayedPaths()) {
+        inherited::GLRender(action);
+        return;
+    }
+
+    depthCleared = false;
+    // the layer adds the delayed paths, nothing above it may cache that
+    SoCacheElement::invalidate(action->getState());
+    inherited::GLRender(action);
+    addDelayedPaths(action);
+}
+
+bool So3DAnnotationLayer::validate(const SoNode *tail, Annotation &annotation)
+{
+    // the paths follow the changes below their own nodes, removing a node
+    // truncates them
+    if (full(annotation.subPath)->getTail() != tail) {
+        return false;
+    }
+    SoNode *head = annotation.subPath->getHead();
+    SoChildList *children = getChildren();
+    int index = annotation.childIndex;
+    if (index >= children->getLength() || (*children)[index] != head) {
+        index = children->find(head);
+        if (index < 0) {
+            return false;
+        }
+        annotation.childIndex = index;
+    }
+    return true;
+}
+
+void So3DAnnotationLayer::fillFullPath(const SoPath *layerPath,
+                                       const Annotation &annotation,
+                                       SoTempPath *path)
+{
+    // the path above the layer may differ from the last frame. Refilled in
+    // place, the lists of the path keep their memory.
+    auto prefix = full(layerPath);
+    path->truncate(0);
+    for (int i = 0; i < prefix->getLength(); ++i) {
+        path->simpleAppend(prefix->getNode(i), prefix->getIndex(i));
+    }
+    auto subPath = full(annotation.subPath);
+    path->simpleAppend(subPath->getHead(), annotation.childIndex);
+    for (int i = 1; i < subPath->getLength(); ++i) {
+        path->simpleAppend(subPath->getNode(i), subPath->getIndex(i));
+    }
+}
+
+void So3DAnnotationLayer::addDelayedPaths(SoGLRenderAction *action)
+{
+    // ends at this layer, the children are done
+    const SoPath *layerPath = action->getCurPath();
+    for (auto it = annotations.begin(); it != annotations.end();) {
+        Annotation &annotation = it->second;
+        if (!validate(it->first, annotation)) {
+            release(annotation);
+            it = annotations.erase(it);
+            continue;
+        }
+
+        // the action takes its own reference until the delayed paths are
+        // drawn, the layer keeps the path for the next frame. A layer
+        // traversed twice in a frame still has it queued and needs a new
+        // one, owned by the action alone.
+        SoTempPath *path = annotation.fullPath;
+        if (path->getRefCount() > 1) {
+            path = new SoTempPath(annotation.fullPath->getLength());
+            ++pathAllocations;
+        }
+        fillFullPath(layerPath, annotation, path);
+        action->addDelayedPath(path);
+        ++it;
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file So3DAnnotationLayer.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:05:00, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/nodes/SoSeparator.h>
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class SoPath;
+class SoTempPath;
+
+namespace Gui
+{
+
+/*! @brief Shared depth clear and persistent delayed paths for 3D annotations.
+ *
+ * A So3DAnnotation clears the depth buffer before it draws itself. Below a
+ * layer only the first annotation of a frame clears, so all annotations of
+ * the layer are drawn over the scene and depth tested against each other.
+ *
+ * The annotations below a layer also do not queue a copy of their path
+ * every frame. The layer keeps the part of the path below itself, and one
+ * full path per annotation that is refilled from the path of the layer in
+ * every frame, so the separators around an annotation can cache their
+ * rendering. The full paths do not reference their nodes, nothing above
+ * the layer is kept alive between frames.
+ *
+ * An annotation stays registered until it leaves the layer or is removed
+ * with removeAnnotations, e.g. when it stops drawing from a delayed path.
+ *
+ * The layer must be traversed every frame and does not cache itself. It is
+ * registered by So3DAnnotation::initClass.
+ */
+class So3DAnnotationLayer : public SoSeparator
+{
+    using inherited = SoSeparator;
+
+    SO_NODE_HEADER(So3DAnnotationLayer);
+
+  public:
+    static void initClass();
+    So3DAnnotationLayer();
+
+    //! the innermost layer on path, nullptr if there is none.
+    static So3DAnnotationLayer *find(const SoPath *path);
+
+    //! clears the depth buffer if no annotation did in this frame.
+    void clearDepth();
+    //! keeps the current path of action, which ends at an annotation.
+    void addAnnotation(SoGLRenderAction *action);
+    //! drops the paths ending at tail from every layer.
+    static void removeAnnotations(const SoNode *tail);
+    size_t getNumAnnotations() const { return annotations.size(); }
+
+    void GLRender(SoGLRenderAction *action) override;
+
+    size_t depthClears{0};     //!< glClear calls of the annotations below.
+    size_t pathAllocations{0}; //!< paths created for the annotations.
+
+  protected:
+    ~So3DAnnotationLayer() override;
+
+  private:
+    struct Annotation {
+        SoPath *subPath{nullptr};      // from the child of the layer on
+        SoTempPath *fullPath{nullptr}; // queued every frame
+        int childIndex{-1};            // of the head of subPath
+    };
+
+    static void release(Annotation &annotation);
+    bool validate(const SoNode *tail, Annotation &annotation);
+    static void fillFullPath(const SoPath *layerPath,
+                             const Annotation &annotation, SoTempPath *path);
+    void addDelayedPaths(SoGLRenderAction *action);
+
+    bool depthCleared{false};
+    std::unordered_multimap<const SoNode *, Annotation> annotations;
+
+    static std::vector<So3DAnnotationLayer *> layers;
+};
+
+} // namespace Gui
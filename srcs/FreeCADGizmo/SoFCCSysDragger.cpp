@@ -21,9 +21,17 @@
  ***************************************************************************/
 #include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include <Inventor/SbRotation.h>
+#include <Inventor/SbString.h>
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SoFullPath.h>
+#include <Inventor/SoNodeKitPath.h>
 #include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/elements/SoPickStyleElement.h>
 #include <Inventor/elements/SoLazyElement.h>
 #include <Inventor/engines/SoComposeVec3f.h>
 #include <Inventor/nodes/SoAnnotation.h>
@@ -45,8 +53,11 @@
 #include <Inventor/nodes/SoSwitch.h>
 #include <Inventor/nodes/SoTranslation.h>
 
+#include "DraggerMotion.h"
 #include "So3DAnnotation.h"
+#include "So3DAnnotationLayer.h"
 #include "SoFCCSysDragger.h"
+#include "SoFCGizmoShape.h"
 
 /*
    GENERAL NOTE ON COIN3D CUSTOM DRAGGERS
@@ -82,11 +93,54 @@
    names
    * descriptive to avoid collisions.
 
-   * this is point of the SoGroup accessed from SoFCDB::getStorage().
+   * this is point of the SoGroup accessed from getStorage().
 */
 
 using namespace Gui;
 
+namespace
+{
+// the default parts are only referenced by the draggers using them, without
+// this they would die with the last dragger and the next one would find
+// nothing by name.
+SoGroup *getStorage()
+{
+    static SoGroup *storage = [] {
+        auto group = new SoGroup();
+        group->ref();
+        return group;
+    }();
+    return storage;
+}
+
+// constant rotations of SoFCCSysDragger, in the order of
+// SoFCGizmoShape::Handle
+const char *const RotationParts[] = {
+    "xTranslatorRotation",        "yTranslatorRotation",
+    "zTranslatorRotation",        "xyPlanarTranslatorRotation",
+    "yzPlanarTranslatorRotation", "zxPlanarTranslatorRotation",
+    "xRotatorRotation",           "yRotatorRotation",
+    "zRotatorRotation",
+};
+
+// switch, color and dragger parts of SoFCCSysDragger, in the order of
+// SoFCGizmoShape::Handle
+const char *const HandleParts[][3] = {
+    {"xTranslatorSwitch", "xTranslatorColor", "xTranslatorDragger"},
+    {"yTranslatorSwitch", "yTranslatorColor", "yTranslatorDragger"},
+    {"zTranslatorSwitch", "zTranslatorColor", "zTranslatorDragger"},
+    {"xyPlanarTranslatorSwitch", "xyPlanarTranslatorColor",
+     "xyPlanarTranslatorDragger"},
+    {"yzPlanarTranslatorSwitch", "yzPlanarTranslatorColor",
+     "yzPlanarTranslatorDragger"},
+    {"zxPlanarTranslatorSwitch", "zxPlanarTranslatorColor",
+     "zxPlanarTranslatorDragger"},
+    {"xRotatorSwitch", "xRotatorColor", "xRotatorDragger"},
+    {"yRotatorSwitch", "yRotatorColor", "yRotatorDragger"},
+    {"zRotatorSwitch", "zRotatorColor", "zRotatorDragger"},
+};
+} // namespace
+
 SO_KIT_SOURCE(TDragger)
 
 void TDragger::initClass()
@@ -168,6 +222,9 @@ void TDragger::buildFirstInstance()
     colorActive->rgb.setValue(1.0, 1.0, 0.0);
     localTranslatorActive->addChild(colorActive);
     localTranslatorActive->addChild(geometryGroup);
+
+    getStorage()->addChild(localTranslator);
+    getStorage()->addChild(localTranslatorActive);
 }
 
 SoGroup *TDragger::buildGeometry()
@@ -235,13 +292,19 @@ void TDragger::motionCB(void *, SoDragger *d)
 {
     auto sudoThis = static_cast<TDragger *>(d);
     assert(sudoThis);
-    sudoThis->drag();
+    sudoThis->motionCoalescer.motion(sudoThis->getNormalizedLocaterPosition());
+}
+
+void TDragger::applyMotionCB(SoDragger *d, const SbVec2f &locator)
+{
+    static_cast<TDragger *>(d)->drag(locator);
 }
 
 void TDragger::finishCB(void *, SoDragger *d)
 {
     auto sudoThis = static_cast<TDragger *>(d);
     assert(sudoThis);
+    sudoThis->motionCoalescer.flush();
     sudoThis->dragFinish();
 }
 
@@ -261,22 +324,15 @@ void TDragger::fieldSensorCB(void *f, SoSensor *)
 
 void TDragger::valueChangedCB(void *, SoDragger *d)
 {
-    auto sudoThis = dynamic_cast<TDragger *>(d);
-    assert(sudoThis);
-    SbMatrix matrix =
-        sudoThis->getMotionMatrix(); // clazy:exclude=rule-of-two-soft
-
-    // all this just to get the translation?
-    SbVec3f trans, scaleDummy;
-    SbRotation rotationDummy, scaleOrientationDummy;
-    matrix.getTransform(trans, rotationDummy, scaleDummy,
-                        scaleOrientationDummy);
+    assert(d && d->isOfType(TDragger::getClassTypeId()));
+    auto sudoThis = static_cast<TDragger *>(d);
+    SbVec3f trans = getMotionTranslation(sudoThis->getMotionMatrix());
 
-    sudoThis->fieldSensor.detach();
     if (sudoThis->translation.getValue() != trans) {
+        sudoThis->fieldSensor.detach();
         sudoThis->translation = trans;
+        sudoThis->fieldSensor.attach(&sudoThis->translation);
     }
-    sudoThis->fieldSensor.attach(&sudoThis->translation);
 }
 
 void TDragger::dragStart()
@@ -284,31 +340,33 @@ void TDragger::dragStart()
     SoSwitch *sw;
     sw = SO_GET_ANY_PART(this, "translatorSwitch", SoSwitch);
     SoInteractionKit::setSwitchValue(sw, 1);
+    // O(1) matrix lookups for the rest of the drag
+    matrixCache.watch(getPickPath());
+    SbMatrix localToWorld = matrixCache.getLocalToWorld();
 
     // do an initial projection to eliminate discrepancies
     // in arrow head pick. we define the arrow in the y+ direction
     // and we know local space will be relative to this. so y vector
     // line projection will work.
     projector.setViewVolume(this->getViewVolume());
-    projector.setWorkingSpace(this->getLocalToWorldMatrix());
+    projector.setWorkingSpace(localToWorld);
     projector.setLine(SbLine(SbVec3f(0.0, 0.0, 0.0), SbVec3f(0.0, 1.0, 0.0)));
     SbVec3f hitPoint = projector.project(getNormalizedLocaterPosition());
 
     projector.setLine(SbLine(SbVec3f(0.0, 0.0, 0.0), hitPoint));
 
-    SbMatrix localToWorld = getLocalToWorldMatrix();
     localToWorld.multVecMatrix(hitPoint, hitPoint);
     setStartingPoint((hitPoint));
 
     translationIncrementCount.setValue(0);
 }
 
-void TDragger::drag()
+void TDragger::drag(const SbVec2f &locator)
 {
     projector.setViewVolume(this->getViewVolume());
-    projector.setWorkingSpace(this->getLocalToWorldMatrix());
+    projector.setWorkingSpace(matrixCache.getLocalToWorld());
 
-    SbVec3f hitPoint = projector.project(getNormalizedLocaterPosition());
+    SbVec3f hitPoint = projector.project(locator);
     SbVec3f startingPoint = getLocalStartingPoint();
     SbVec3f localMovement = hitPoint - startingPoint;
 
@@ -344,11 +402,19 @@ void TDragger::drag()
 
 void TDragger::dragFinish()
 {
+    matrixCache.release();
+
     SoSwitch *sw;
     sw = SO_GET_ANY_PART(this, "translatorSwitch", SoSwitch);
     SoInteractionKit::setSwitchValue(sw, 0);
 }
 
+void TDragger::GLRender(SoGLRenderAction *action)
+{
+    matrixCache.setParentToWorld(SoModelMatrixElement::get(action->getState()));
+    inherited::GLRender(action);
+}
+
 SbBool TDragger::setUpConnections(SbBool onoff, SbBool doitalways)
 {
     if (!doitalways && this->connectionsSetUp == onoff) {
@@ -474,7 +540,7 @@ void TPlanarDragger::buildFirstInstance()
     auto localTranslator = new SoSeparator();
     localTranslator->setName("CSysDynamics_TPlanarDragger_Translator");
     localTranslator->addChild(geometryGroup);
-    // SoFCDB::getStorage()->addChild(localTranslator);
+    getStorage()->addChild(localTranslator);
 
     auto localTranslatorActive = new SoSeparator();
     localTranslatorActive->setName(
@@ -483,7 +549,7 @@ void TPlanarDragger::buildFirstInstance()
     colorActive->rgb.setValue(1.0, 1.0, 0.0);
     localTranslatorActive->addChild(colorActive);
     localTranslatorActive->addChild(geometryGroup);
-    // SoFCDB::getStorage()->addChild(localTranslatorActive);
+    getStorage()->addChild(localTranslatorActive);
 }
 
 SoGroup *TPlanarDragger::buildGeometry()
@@ -527,13 +593,19 @@ void TPlanarDragger::motionCB(void *, SoDragger *d)
 {
     auto sudoThis = static_cast<TPlanarDragger *>(d);
     assert(sudoThis);
-    sudoThis->drag();
+    sudoThis->motionCoalescer.motion(sudoThis->getNormalizedLocaterPosition());
+}
+
+void TPlanarDragger::applyMotionCB(SoDragger *d, const SbVec2f &locator)
+{
+    static_cast<TPlanarDragger *>(d)->drag(locator);
 }
 
 void TPlanarDragger::finishCB(void *, SoDragger *d)
 {
     auto sudoThis = static_cast<TPlanarDragger *>(d);
     assert(sudoThis);
+    sudoThis->motionCoalescer.flush();
     sudoThis->dragFinish();
 }
 
@@ -553,22 +625,15 @@ void TPlanarDragger::fieldSensorCB(void *f, SoSensor *)
 
 void TPlanarDragger::valueChangedCB(void *, SoDragger *d)
 {
-    auto sudoThis = dynamic_cast<TPlanarDragger *>(d);
-    assert(sudoThis);
-    SbMatrix matrix =
-        sudoThis->getMotionMatrix(); // clazy:exclude=rule-of-two-soft
-
-    // all this just to get the translation?
-    SbVec3f trans, scaleDummy;
-    SbRotation rotationDummy, scaleOrientationDummy;
-    matrix.getTransform(trans, rotationDummy, scaleDummy,
-                        scaleOrientationDummy);
+    assert(d && d->isOfType(TPlanarDragger::getClassTypeId()));
+    auto sudoThis = static_cast<TPlanarDragger *>(d);
+    SbVec3f trans = getMotionTranslation(sudoThis->getMotionMatrix());
 
-    sudoThis->fieldSensor.detach();
     if (sudoThis->translation.getValue() != trans) {
+        sudoThis->fieldSensor.detach();
         sudoThis->translation = trans;
+        sudoThis->fieldSensor.attach(&sudoThis->translation);
     }
-    sudoThis->fieldSensor.attach(&sudoThis->translation);
 }
 
 void TPlanarDragger::dragStart()
@@ -576,14 +641,16 @@ void TPlanarDragger::dragStart()
     SoSwitch *sw;
     sw = SO_GET_ANY_PART(this, "planarTranslatorSwitch", SoSwitch);
     SoInteractionKit::setSwitchValue(sw, 1);
+    // O(1) matrix lookups for the rest of the drag
+    matrixCache.watch(getPickPath());
+    SbMatrix localToWorld = matrixCache.getLocalToWorld();
 
     projector.setViewVolume(this->getViewVolume());
-    projector.setWorkingSpace(this->getLocalToWorldMatrix());
+    projector.setWorkingSpace(localToWorld);
     projector.setPlane(SbPlane(SbVec3f(0.0, 0.0, 0.0), SbVec3f(1.0, 0.0, 0.0),
                                SbVec3f(0.0, 1.0, 0.0)));
     SbVec3f hitPoint = projector.project(getNormalizedLocaterPosition());
 
-    SbMatrix localToWorld = getLocalToWorldMatrix();
     localToWorld.multVecMatrix(hitPoint, hitPoint);
     setStartingPoint((hitPoint));
 
@@ -591,12 +658,12 @@ void TPlanarDragger::dragStart()
     translationIncrementYCount.setValue(0);
 }
 
-void TPlanarDragger::drag()
+void TPlanarDragger::drag(const SbVec2f &locator)
 {
     projector.setViewVolume(this->getViewVolume());
-    projector.setWorkingSpace(this->getLocalToWorldMatrix());
+    projector.setWorkingSpace(matrixCache.getLocalToWorld());
 
-    SbVec3f hitPoint = projector.project(getNormalizedLocaterPosition());
+    SbVec3f hitPoint = projector.project(locator);
     SbVec3f startingPoint = getLocalStartingPoint();
     SbVec3f localMovement = hitPoint - startingPoint;
 
@@ -637,11 +704,19 @@ void TPlanarDragger::drag()
 
 void TPlanarDragger::dragFinish()
 {
+    matrixCache.release();
+
     SoSwitch *sw;
     sw = SO_GET_ANY_PART(this, "planarTranslatorSwitch", SoSwitch);
     SoInteractionKit::setSwitchValue(sw, 0);
 }
 
+void TPlanarDragger::GLRender(SoGLRenderAction *action)
+{
+    matrixCache.setParentToWorld(SoModelMatrixElement::get(action->getState()));
+    inherited::GLRender(action);
+}
+
 SbBool TPlanarDragger::setUpConnections(SbBool onoff, SbBool doitalways)
 {
     if (!doitalways && this->connectionsSetUp == onoff) {
@@ -777,7 +852,7 @@ void RDragger::buildFirstInstance()
     auto localRotator = new SoSeparator();
     localRotator->setName("CSysDynamics_RDragger_Rotator");
     localRotator->addChild(geometryGroup);
-    // SoFCDB::getStorage()->addChild(localRotator);
+    getStorage()->addChild(localRotator);
 
     auto localRotatorActive = new SoSeparator();
     localRotatorActive->setName("CSysDynamics_RDragger_RotatorActive");
@@ -785,7 +860,7 @@ void RDragger::buildFirstInstance()
     colorActive->rgb.setValue(1.0, 1.0, 0.0);
     localRotatorActive->addChild(colorActive);
     localRotatorActive->addChild(geometryGroup);
-    // SoFCDB::getStorage()->addChild(localRotatorActive);
+    getStorage()->addChild(localRotatorActive);
 }
 
 SoGroup *RDragger::buildGeometry()
@@ -850,13 +925,19 @@ void RDragger::motionCB(void *, SoDragger *d)
 {
     auto sudoThis = static_cast<RDragger *>(d);
     assert(sudoThis);
-    sudoThis->drag();
+    sudoThis->motionCoalescer.motion(sudoThis->getNormalizedLocaterPosition());
+}
+
+void RDragger::applyMotionCB(SoDragger *d, const SbVec2f &locator)
+{
+    static_cast<RDragger *>(d)->drag(locator);
 }
 
 void RDragger::finishCB(void *, SoDragger *d)
 {
     auto sudoThis = static_cast<RDragger *>(d);
     assert(sudoThis);
+    sudoThis->motionCoalescer.flush();
     sudoThis->dragFinish();
 }
 
@@ -876,22 +957,15 @@ void RDragger::fieldSensorCB(void *f, SoSensor *)
 
 void RDragger::valueChangedCB(void *, SoDragger *d)
 {
-    auto sudoThis = dynamic_cast<RDragger *>(d);
-    assert(sudoThis);
-    SbMatrix matrix =
-        sudoThis->getMotionMatrix(); // clazy:exclude=rule-of-two-soft
-
-    // all this just to get the translation?
-    SbVec3f translationDummy, scaleDummy;
-    SbRotation localRotation, scaleOrientationDummy;
-    matrix.getTransform(translationDummy, localRotation, scaleDummy,
-                        scaleOrientationDummy);
+    assert(d && d->isOfType(RDragger::getClassTypeId()));
+    auto sudoThis = static_cast<RDragger *>(d);
+    SbRotation localRotation = getMotionRotation(sudoThis->getMotionMatrix());
 
-    sudoThis->fieldSensor.detach();
     if (sudoThis->rotation.getValue() != localRotation) {
+        sudoThis->fieldSensor.detach();
         sudoThis->rotation = localRotation;
+        sudoThis->fieldSensor.attach(&sudoThis->rotation);
     }
-    sudoThis->fieldSensor.attach(&sudoThis->rotation);
 }
 
 void RDragger::dragStart()
@@ -899,9 +973,12 @@ void RDragger::dragStart()
     SoSwitch *sw;
     sw = SO_GET_ANY_PART(this, "rotatorSwitch", SoSwitch);
     SoInteractionKit::setSwitchValue(sw, 1);
+    // O(1) matrix lookups for the rest of the drag
+    matrixCache.watch(getPickPath());
+    SbMatrix localToWorld = matrixCache.getLocalToWorld();
 
     projector.setViewVolume(this->getViewVolume());
-    projector.setWorkingSpace(this->getLocalToWorldMatrix());
+    projector.setWorkingSpace(localToWorld);
     projector.setPlane(SbPlane(SbVec3f(0.0, 0.0, 1.0), 0.0));
 
     SbVec3f hitPoint;
@@ -910,20 +987,19 @@ void RDragger::dragStart()
     }
     hitPoint.normalize();
 
-    SbMatrix localToWorld = getLocalToWorldMatrix();
     localToWorld.multVecMatrix(hitPoint, hitPoint);
     setStartingPoint((hitPoint));
 
     rotationIncrementCount.setValue(0);
 }
 
-void RDragger::drag()
+void RDragger::drag(const SbVec2f &locator)
 {
     projector.setViewVolume(this->getViewVolume());
-    projector.setWorkingSpace(this->getLocalToWorldMatrix());
+    projector.setWorkingSpace(matrixCache.getLocalToWorld());
 
     SbVec3f hitPoint;
-    if (!projector.tryProject(getNormalizedLocaterPosition(), 0.0, hitPoint)) {
+    if (!projector.tryProject(locator, 0.0, hitPoint)) {
         return;
     }
     hitPoint.normalize();
@@ -973,11 +1049,19 @@ void RDragger::drag()
 
 void RDragger::dragFinish()
 {
+    matrixCache.release();
+
     SoSwitch *sw;
     sw = SO_GET_ANY_PART(this, "rotatorSwitch", SoSwitch);
     SoInteractionKit::setSwitchValue(sw, 0);
 }
 
+void RDragger::GLRender(SoGLRenderAction *action)
+{
+    matrixCache.setParentToWorld(SoModelMatrixElement::get(action->getState()));
+    inherited::GLRender(action);
+}
+
 SbBool RDragger::setUpConnections(SbBool onoff, SbBool doitalways)
 {
     if (!doitalways && this->connectionsSetUp == onoff) {
@@ -1025,6 +1109,7 @@ void SoFCCSysDragger::initClass()
     TDragger::initClass();
     TPlanarDragger::initClass();
     RDragger::initClass();
+    SoFCGizmoShape::initClass();
     SO_KIT_INIT_CLASS(SoFCCSysDragger, SoDragger, "Dragger");
 }
 
@@ -1165,6 +1250,10 @@ SoFCCSysDragger::SoFCCSysDragger() : axisScale(1.0f, 1.0f, 1.0f)
     SO_KIT_ADD_FIELD(rotationIncrementCountY, (0));
     SO_KIT_ADD_FIELD(rotationIncrementCountZ, (0));
 
+    if (SO_KIT_IS_FIRST_INSTANCE()) {
+        buildFirstInstance();
+    }
+
     SO_KIT_ADD_FIELD(draggerSize, (1.0));
     SO_KIT_ADD_FIELD(autoScaleResult, (1.0));
 
@@ -1259,39 +1348,12 @@ SoFCCSysDragger::SoFCCSysDragger() : axisScale(1.0f, 1.0f, 1.0f)
     sw = SO_GET_ANY_PART(this, "zRotatorSwitch", SoSwitch);
     SoInteractionKit::setSwitchValue(sw, SO_SWITCH_ALL);
 
-    // Rotations
-
-    SoRotation *localRotation;
-    SbRotation tempRotation;
-    auto angle = static_cast<float>(M_PI / 2.0);
-    // Translator
-    localRotation = SO_GET_ANY_PART(this, "xTranslatorRotation", SoRotation);
-    localRotation->rotation.setValue(SbVec3f(0.0, 0.0, -1.0), angle);
-    localRotation = SO_GET_ANY_PART(this, "yTranslatorRotation", SoRotation);
-    localRotation->rotation.setValue(SbRotation::identity());
-    localRotation = SO_GET_ANY_PART(this, "zTranslatorRotation", SoRotation);
-    localRotation->rotation.setValue(SbVec3f(1.0, 0.0, 0.0), angle);
-    // Planar Translator
-    localRotation =
-        SO_GET_ANY_PART(this, "xyPlanarTranslatorRotation", SoRotation);
-    localRotation->rotation.setValue(SbRotation::identity());
-    localRotation =
-        SO_GET_ANY_PART(this, "yzPlanarTranslatorRotation", SoRotation);
-    localRotation->rotation.setValue(SbVec3f(0.0, -1.0, 0.0), angle);
-    localRotation =
-        SO_GET_ANY_PART(this, "zxPlanarTranslatorRotation", SoRotation);
-    localRotation->rotation.setValue(SbVec3f(1.0, 0.0, 0.0), angle);
-    // Rotator
-    localRotation = SO_GET_ANY_PART(this, "xRotatorRotation", SoRotation);
-    tempRotation = SbRotation(SbVec3f(1.0, 0.0, 0.0), angle);
-    tempRotation *= SbRotation(SbVec3f(0.0, 0.0, 1.0), angle);
-    localRotation->rotation.setValue(tempRotation);
-    localRotation = SO_GET_ANY_PART(this, "yRotatorRotation", SoRotation);
-    tempRotation = SbRotation(SbVec3f(0.0, -1.0, 0.0), angle);
-    tempRotation *= SbRotation(SbVec3f(0.0, 0.0, -1.0), angle);
-    localRotation->rotation.setValue(tempRotation);
-    localRotation = SO_GET_ANY_PART(this, "zRotatorRotation", SoRotation);
-    localRotation->rotation.setValue(SbRotation::identity());
+    // Rotations, constant and shared by all instances
+    for (auto part : RotationParts) {
+        SbString name("CSysDynamics_SoFCCSysDragger_");
+        name += part;
+        this->setPartAsDefault(part, name.getString());
+    }
 
     // this is for non-autoscale mode. this will be disconnected for autoscale
     // and won't be used. see setUpAutoScale.
@@ -1313,27 +1375,43 @@ SoFCCSysDragger::SoFCCSysDragger() : axisScale(1.0f, 1.0f, 1.0f)
     rotationSensor.setData(this);
     rotationSensor.setPriority(0);
 
-    cameraSensor.setFunction(&SoFCCSysDragger::cameraCB);
-    cameraSensor.setData(this);
-
-    idleSensor.setFunction(&SoFCCSysDragger::idleCB);
-    idleSensor.setData(this);
-
     this->addFinishCallback(&SoFCCSysDragger::finishDragCB, this);
 
+    gizmoShape = new SoFCGizmoShape();
+    gizmoShape->ref();
+
     this->setUpConnections(TRUE, TRUE);
 }
 
+void SoFCCSysDragger::buildFirstInstance()
+{
+    auto addRotation = [](const char *part, const SbRotation &rotation) {
+        SbString name("CSysDynamics_SoFCCSysDragger_");
+        name += part;
+        auto localRotation = new SoRotation();
+        localRotation->setName(name.getString());
+        localRotation->rotation.setValue(rotation);
+        getStorage()->addChild(localRotation);
+    };
+
+    for (int h = 0; h < SoFCGizmoShape::HandleCount; ++h) {
+        addRotation(RotationParts[h],
+                    SoFCGizmoShape::getHandleRotation(
+                        static_cast<SoFCGizmoShape::Handle>(h)));
+    }
+}
+
 SoFCCSysDragger::~SoFCCSysDragger()
 {
     translationSensor.setData(nullptr);
     translationSensor.detach();
     rotationSensor.setData(nullptr);
     rotationSensor.detach();
-    cameraSensor.setData(nullptr);
-    cameraSensor.detach();
-    idleSensor.setData(nullptr);
-    idleSensor.unschedule();
+    if (autoScaler) {
+        autoScaler->remove(this);
+        autoScaler = nullptr;
+    }
+    gizmoShape->unref();
 
     removeValueChangedCallback(&SoFCCSysDragger::valueChangedCB);
     removeFinishCallback(&SoFCCSysDragger::finishDragCB, this);
@@ -1432,63 +1510,70 @@ void SoFCCSysDragger::rotationSensorCB(void *f, SoSensor *)
 
 void SoFCCSysDragger::valueChangedCB(void *, SoDragger *d)
 {
-    auto sudoThis = dynamic_cast<SoFCCSysDragger *>(d);
-    assert(sudoThis);
-    SbMatrix matrix =
-        sudoThis->getMotionMatrix(); // clazy:exclude=rule-of-two-soft
-
-    // all this just to get the translation?
-    SbVec3f localTranslation, scaleDummy;
-    SbRotation localRotation, scaleOrientationDummy;
-    matrix.getTransform(localTranslation, localRotation, scaleDummy,
-                        scaleOrientationDummy);
+    assert(d && d->isOfType(SoFCCSysDragger::getClassTypeId()));
+    auto sudoThis = static_cast<SoFCCSysDragger *>(d);
+    const SbMatrix &matrix = sudoThis->getMotionMatrix();
 
-    sudoThis->translationSensor.detach();
+    SbVec3f localTranslation = getMotionTranslation(matrix);
     if (sudoThis->translation.getValue() != localTranslation) {
+        sudoThis->translationSensor.detach();
         sudoThis->translation = localTranslation;
+        sudoThis->translationSensor.attach(&sudoThis->translation);
     }
-    sudoThis->translationSensor.attach(&sudoThis->translation);
 
-    sudoThis->rotationSensor.detach();
+    SbRotation localRotation = getMotionRotation(matrix);
     if (sudoThis->rotation.getValue() != localRotation) {
+        sudoThis->rotationSensor.detach();
         sudoThis->rotation = localRotation;
+        sudoThis->rotationSensor.attach(&sudoThis->rotation);
     }
-    sudoThis->rotationSensor.attach(&sudoThis->rotation);
 }
 
 void SoFCCSysDragger::setUpAutoScale(SoCamera *cameraIn)
 {
-    // note: sofieldsensor checks if the current sensor is already attached
-    // and takes appropriate action. So it is safe to attach to a field without
-    // checking current attachment state.
-    if (cameraIn->getTypeId() == SoOrthographicCamera::getClassTypeId()) {
-        auto localCamera = dynamic_cast<SoOrthographicCamera *>(cameraIn);
-        assert(localCamera);
-        cameraSensor.attach(&localCamera->height);
-        SoScale *localScaleNode = SO_GET_ANY_PART(this, "scaleNode", SoScale);
-        localScaleNode->scaleFactor.disconnect();
-        autoScaleResult.disconnect(&draggerSize);
-        cameraCB(this, nullptr);
-    } else if (cameraIn->getTypeId() == SoPerspectiveCamera::getClassTypeId()) {
-        auto localCamera = dynamic_cast<SoPerspectiveCamera *>(cameraIn);
-        assert(localCamera);
-        cameraSensor.attach(&localCamera->position);
-        SoScale *localScaleNode = SO_GET_ANY_PART(this, "scaleNode", SoScale);
-        localScaleNode->scaleFactor.disconnect();
-        autoScaleResult.disconnect(&draggerSize);
-        cameraCB(this, nullptr);
+    if (!cameraIn->isOfType(SoOrthographicCamera::getClassTypeId()) &&
+        !cameraIn->isOfType(SoPerspectiveCamera::getClassTypeId())) {
+        return;
+    }
+
+    SoScale *localScaleNode = SO_GET_ANY_PART(this, "scaleNode", SoScale);
+    localScaleNode->scaleFactor.disconnect();
+    autoScaleResult.disconnect(&draggerSize);
+
+    // all draggers of a camera share one sensor and one scaling pass
+    auto scaler = DraggerAutoScaler::get(cameraIn);
+    if (autoScaler != scaler) {
+        if (autoScaler) {
+            autoScaler->remove(this);
+        }
+        autoScaler = scaler;
+        autoScaler->add(this);
     }
+    updateAutoScale(cameraIn->getViewVolume());
 }
 
-void SoFCCSysDragger::cameraCB(void *data, SoSensor *)
+bool SoFCCSysDragger::updateAutoScale(const SbViewVolume &viewVolume)
 {
-    auto sudoThis = static_cast<SoFCCSysDragger *>(data);
-    if (!sudoThis) {
-        return;
-    }
-    if (!sudoThis->idleSensor.isScheduled()) {
-        sudoThis->idleSensor.schedule();
+    SbMatrix localToWorld = matrixCache.getLocalToWorld();
+    SbVec3f origin;
+    localToWorld.multVecMatrix(SbVec3f(0.0, 0.0, 0.0), origin);
+
+    float radius = draggerSize.getValue() / 2.0;
+    float localScale = viewVolume.getWorldToScreenScale(origin, radius);
+    float sx, sy, sz;
+    axisScale.getValue(sx, sy, sz);
+    SbVec3f scaleVector(localScale / sx, localScale / sy, localScale / sz);
+
+    // every write notifies up to the root, skip the ones that change nothing
+    SoScale *localScaleNode = SO_GET_ANY_PART(this, "scaleNode", SoScale);
+    if (localScaleNode->scaleFactor.getValue().equals(scaleVector,
+                                                      localScale * 1e-6f) &&
+        autoScaleResult.getValue() == localScale) {
+        return false;
     }
+    localScaleNode->scaleFactor.setValue(scaleVector);
+    autoScaleResult.setValue(localScale);
+    return true;
 }
 
 void SoFCCSysDragger::GLRender(SoGLRenderAction *action)
@@ -1496,15 +1581,170 @@ void SoFCCSysDragger::GLRender(SoGLRenderAction *action)
     if (!scaleInited) {
         scaleInited = true;
         updateDraggerCache(action->getCurPath());
+    }
+
+    // the render traversal already knows the matrix above the dragger, no
+    // extra path traversal is needed to get it
+    if (matrixCache.setParentToWorld(
+            SoModelMatrixElement::get(action->getState()))) {
         updateAxisScale();
     }
 
-    inherited::GLRender(action);
+    if (!batchedRendering || action->getCurPathCode() == SoAction::OFF_PATH) {
+        inherited::GLRender(action);
+        return;
+    }
+
+    // the catalog parts stay in place for picking and bounding boxes, only
+    // the drawing goes through the gizmo shape. Like the annotation part it
+    // is drawn on top of the scene after clearing the depth buffer.
+    SoState *state = action->getState();
+    if (!action->isRenderingDelayedPaths()) {
+        So3DAnnotation::addDelayedPath(action);
+        return;
+    }
+
+    syncGizmoShape();
+    So3DAnnotation::clearDepth(action);
+    state->push();
+    SoModelMatrixElement::mult(state, this, getMotionMatrix());
+    SoScale *localScaleNode = SO_GET_ANY_PART(this, "scaleNode", SoScale);
+    SoModelMatrixElement::scaleBy(state, this,
+                                  localScaleNode->scaleFactor.getValue());
+    gizmoShape->GLRender(action);
+    state->pop();
+}
+
+void SoFCCSysDragger::rayPick(SoRayPickAction *action)
+{
+    if (!analyticPicking) {
+        inherited::rayPick(action);
+        return;
+    }
+
+    // the handles are tested in the space the gizmo shape is drawn in,
+    // nothing below the dragger is traversed
+    syncGizmoShape();
+    SoState *state = action->getState();
+    state->push();
+    SoModelMatrixElement::mult(state, this, getMotionMatrix());
+    SoScale *localScaleNode = SO_GET_ANY_PART(this, "scaleNode", SoScale);
+    SoModelMatrixElement::scaleBy(state, this,
+                                  localScaleNode->scaleFactor.getValue());
+    action->setObjectSpace();
+
+    SbVec3f point;
+    int handle = SoFCGizmoShape::pickHandle(
+        action->getLine(), gizmoShape->visibleHandles.getValue(), point);
+    if (handle >= 0 && action->isBetweenPlanes(point)) {
+        // like the pick style of the catalog geometry
+        SoPickStyleElement::set(state, this,
+                                SoPickStyleElement::SHAPE_ON_TOP);
+        addHandleIntersection(action, handle, point);
+    }
+    state->pop();
+}
+
+void SoFCCSysDragger::addHandleIntersection(SoRayPickAction *action,
+                                            int handle, const SbVec3f &point)
+{
+    // SoDragger::isPicked looks for the child dragger in the picked path, so
+    // the path down to it is pushed as if it had been traversed
+    SoNodeKitPath *kitPath =
+        createPathToAnyPart(HandleParts[handle][2], FALSE);
+    if (!kitPath) {
+        return;
+    }
+    kitPath->ref();
+    auto path = reinterpret_cast<SoFullPath *>(static_cast<SoPath *>(kitPath));
+    std::vector<SoAction::PathCode> pathCodes;
+    for (int i = 1; i < path->getLength(); ++i) {
+        pathCodes.push_back(action->getCurPathCode());
+        action->pushCurPath(path->getIndex(i), path->getNode(i));
+    }
+
+    action->addIntersection(point);
+
+    for (auto code = pathCodes.rbegin(); code != pathCodes.rend(); ++code) {
+        action->popCurPath(*code);
+    }
+    kitPath->unref();
+}
+
+void SoFCCSysDragger::setAnalyticPicking(bool on)
+{
+    analyticPicking = on;
+}
+
+void SoFCCSysDragger::setCoalescedMotion(bool on)
+{
+    coalescedMotion = on;
+    for (int h = 0; h < SoFCGizmoShape::HandleCount; ++h) {
+        SoNode *child = getAnyPart(HandleParts[h][2], TRUE);
+        if (h <= SoFCGizmoShape::TranslationZ) {
+            static_cast<TDragger *>(child)->setCoalescedMotion(on);
+        } else if (h <= SoFCGizmoShape::PlanarTranslationZX) {
+            static_cast<TPlanarDragger *>(child)->setCoalescedMotion(on);
+        } else {
+            static_cast<RDragger *>(child)->setCoalescedMotion(on);
+        }
+    }
+}
+
+void SoFCCSysDragger::setBatchedRendering(bool on)
+{
+    if (batchedRendering != on) {
+        batchedRendering = on;
+        // the catalog parts draw the dragger again, a path kept by a layer
+        // would draw it a second time
+        if (!on) {
+            So3DAnnotationLayer::removeAnnotations(this);
+        }
+        touch();
+    }
+}
+
+void SoFCCSysDragger::syncGizmoShape()
+{
+    // the child draggers show their active part while being dragged
+    static const char *const activeSwitches[] = {"translatorSwitch",
+                                                 "planarTranslatorSwitch",
+                                                 "rotatorSwitch"};
+
+    uint32_t visible = 0;
+    uint32_t active = 0;
+    for (int h = 0; h < SoFCGizmoShape::HandleCount; ++h) {
+        auto sw = SO_GET_ANY_PART(this, HandleParts[h][0], SoSwitch);
+        if (sw->whichChild.getValue() != SO_SWITCH_NONE) {
+            visible |= 1u << h;
+        }
+
+        auto color = SO_GET_ANY_PART(this, HandleParts[h][1], SoBaseColor);
+        const SbColor &rgb = color->rgb.getNum() > 0 ? color->rgb[0]
+                                                     : SbColor(1.0, 1.0, 1.0);
+        if (gizmoShape->handleColor.getNum() <= h ||
+            gizmoShape->handleColor[h] != rgb) {
+            gizmoShape->handleColor.set1Value(h, rgb);
+        }
+
+        auto child = SO_GET_ANY_PART(this, HandleParts[h][2], SoDragger);
+        auto childSwitch = static_cast<SoSwitch *>(
+            child->getPart(activeSwitches[h / 3], FALSE));
+        if (childSwitch && childSwitch->whichChild.getValue() == 1) {
+            active |= 1u << h;
+        }
+    }
+    if (gizmoShape->visibleHandles.getValue() != visible) {
+        gizmoShape->visibleHandles = visible;
+    }
+    if (gizmoShape->activeHandles.getValue() != active) {
+        gizmoShape->activeHandles = active;
+    }
 }
 
 void SoFCCSysDragger::updateAxisScale()
 {
-    SbMatrix localToWorld = getLocalToWorldMatrix();
+    SbMatrix localToWorld = matrixCache.getLocalToWorld();
     SbVec3f origin;
     localToWorld.multVecMatrix(SbVec3f(0.0, 0.0, 0.0), origin);
     SbVec3f vx, vy, vz;
@@ -1516,7 +1756,9 @@ void SoFCCSysDragger::updateAxisScale()
     float z = std::max((vz - origin).length(), 1e-7f);
     if (!axisScale.equals(SbVec3f(x, y, z), 1e-7f)) {
         axisScale.setValue(x, y, z);
-        idleCB(this, &idleSensor);
+        if (autoScaler && autoScaler->getCamera()) {
+            updateAutoScale(autoScaler->getCamera()->getViewVolume());
+        }
     }
 }
 
@@ -1530,46 +1772,18 @@ void SoFCCSysDragger::handleEvent(SoHandleEventAction *action)
     this->unref();
 }
 
-void SoFCCSysDragger::idleCB(void *data, SoSensor *)
-{
-    auto sudoThis = static_cast<SoFCCSysDragger *>(data);
-    if (!data) {
-        return;
-    }
-    SoField *field = sudoThis->cameraSensor.getAttachedField();
-    if (field) {
-        auto camera = static_cast<SoCamera *>(field->getContainer());
-        SbMatrix localToWorld = sudoThis->getLocalToWorldMatrix();
-        SbVec3f origin;
-        localToWorld.multVecMatrix(SbVec3f(0.0, 0.0, 0.0), origin);
-
-        SbViewVolume viewVolume = camera->getViewVolume();
-        float radius = sudoThis->draggerSize.getValue() / 2.0;
-        float localScale = viewVolume.getWorldToScreenScale(origin, radius);
-        float sx, sy, sz;
-        sudoThis->axisScale.getValue(sx, sy, sz);
-        SbVec3f scaleVector(localScale / sx, localScale / sy, localScale / sz);
-        SoScale *localScaleNode =
-            SO_GET_ANY_PART(sudoThis, "scaleNode", SoScale);
-        localScaleNode->scaleFactor.setValue(scaleVector);
-        sudoThis->autoScaleResult.setValue(localScale);
-    }
-}
-
 void SoFCCSysDragger::finishDragCB(void *data, SoDragger *)
 {
     auto sudoThis = static_cast<SoFCCSysDragger *>(data);
     assert(sudoThis);
 
     // note: when creating a second view of the document and then closing
-    // the first viewer it deletes the camera. However, the attached field
-    // of the cameraSensor will be detached automatically.
-    SoField *field = sudoThis->cameraSensor.getAttachedField();
-    if (field) {
-        auto camera = static_cast<SoCamera *>(field->getContainer());
-        if (camera->getTypeId() == SoPerspectiveCamera::getClassTypeId()) {
-            cameraCB(sudoThis, nullptr);
-        }
+    // the first viewer it deletes the camera. The scaler then has no camera
+    // any more and the dragger keeps its scale.
+    auto scaler = sudoThis->autoScaler;
+    if (scaler && scaler->getCamera() &&
+        scaler->getCamera()->isOfType(SoPerspectiveCamera::getClassTypeId())) {
+        scaler->schedule();
     }
 }
 
@@ -31,11 +31,15 @@
 #include <Inventor/projectors/SbLineProjector.h>
 #include <Inventor/projectors/SbPlaneProjector.h>
 #include <Inventor/sensors/SoFieldSensor.h>
-#include <Inventor/sensors/SoIdleSensor.h>
 
+#include "DraggerAutoScaler.h"
+#include "DraggerMatrixCache.h"
+#include "DraggerMotionCoalescer.h"
 #include "So3DAnnotation.h"
+#include "SoFCGizmoShape.h"
 
 class SoCamera;
+class SbViewVolume;
 
 namespace Gui
 {
@@ -65,6 +69,9 @@ class TDragger : public SoDragger
         translationIncrementCount; //!< number of steps. used from outside.
     SoSFFloat autoScaleResult;     //!< set from parent dragger.
 
+    //! one drag step per frame, see DraggerMotionCoalescer.
+    void setCoalescedMotion(bool on) { motionCoalescer.setEnabled(on); }
+
   protected:
     ~TDragger() override;
     SbBool setUpConnections(SbBool onoff, SbBool doitalways = FALSE) override;
@@ -74,13 +81,18 @@ class TDragger : public SoDragger
     static void finishCB(void *, SoDragger *d);
     static void fieldSensorCB(void *f, SoSensor *);
     static void valueChangedCB(void *, SoDragger *d);
+    static void applyMotionCB(SoDragger *d, const SbVec2f &locator);
 
     void dragStart();
-    void drag();
+    void drag(const SbVec2f &locator);
     void dragFinish();
 
+    void GLRender(SoGLRenderAction *action) override;
+
     SoFieldSensor fieldSensor;
     SbLineProjector projector;
+    DraggerMatrixCache matrixCache{this};
+    DraggerMotionCoalescer motionCoalescer{this, &TDragger::applyMotionCB};
 
   private:
     void buildFirstInstance();
@@ -102,7 +114,7 @@ class TDragger : public SoDragger
  */
 class TPlanarDragger : public SoDragger
 {
-    SO_KIT_HEADER(TDragger);
+    SO_KIT_HEADER(TPlanarDragger);
     SO_KIT_CATALOG_ENTRY_HEADER(planarTranslatorSwitch);
     SO_KIT_CATALOG_ENTRY_HEADER(planarTranslator);
     SO_KIT_CATALOG_ENTRY_HEADER(planarTranslatorActive);
@@ -120,6 +132,9 @@ class TPlanarDragger : public SoDragger
         translationIncrementYCount; //!< number of steps. used from outside.
     SoSFFloat autoScaleResult;      //!< set from parent dragger.
 
+    //! one drag step per frame, see DraggerMotionCoalescer.
+    void setCoalescedMotion(bool on) { motionCoalescer.setEnabled(on); }
+
   protected:
     ~TPlanarDragger() override;
     SbBool setUpConnections(SbBool onoff, SbBool doitalways = FALSE) override;
@@ -129,13 +144,19 @@ class TPlanarDragger : public SoDragger
     static void finishCB(void *, SoDragger *d);
     static void fieldSensorCB(void *f, SoSensor *);
     static void valueChangedCB(void *, SoDragger *d);
+    static void applyMotionCB(SoDragger *d, const SbVec2f &locator);
 
     void dragStart();
-    void drag();
+    void drag(const SbVec2f &locator);
     void dragFinish();
 
+    void GLRender(SoGLRenderAction *action) override;
+
     SoFieldSensor fieldSensor;
     SbPlaneProjector projector;
+    DraggerMatrixCache matrixCache{this};
+    DraggerMotionCoalescer motionCoalescer{this,
+                                           &TPlanarDragger::applyMotionCB};
 
   private:
     void buildFirstInstance();
@@ -167,6 +188,9 @@ class RDragger : public SoDragger
     SoSFInt32 rotationIncrementCount; //!< number of steps. used from outside.
     SoSFColor color;                  //!< set from outside. non-active color.
 
+    //! one drag step per frame, see DraggerMotionCoalescer.
+    void setCoalescedMotion(bool on) { motionCoalescer.setEnabled(on); }
+
   protected:
     ~RDragger() override;
     SbBool setUpConnections(SbBool onoff, SbBool doitalways = FALSE) override;
@@ -176,13 +200,18 @@ class RDragger : public SoDragger
     static void finishCB(void *, SoDragger *d);
     static void fieldSensorCB(void *f, SoSensor *);
     static void valueChangedCB(void *, SoDragger *d);
+    static void applyMotionCB(SoDragger *d, const SbVec2f &locator);
 
     void dragStart();
-    void drag();
+    void drag(const SbVec2f &locator);
     void dragFinish();
 
+    void GLRender(SoGLRenderAction *action) override;
+
     SoFieldSensor fieldSensor;
     SbPlaneProjector projector;
+    DraggerMatrixCache matrixCache{this};
+    DraggerMotionCoalescer motionCoalescer{this, &RDragger::applyMotionCB};
     float arcRadius;
 
   private:
@@ -297,10 +326,10 @@ class SoFCCSysDragger : public SoDragger
     SoSFFloat autoScaleResult; //!< result of autoscale calculation and used by
                                //!< childdraggers. Don't use.
 
-    SoIdleSensor idleSensor; //!< might be overkill, but want to make sure of
-                             //!< performance.
     void setUpAutoScale(
         SoCamera *cameraIn); //!< used to setup the auto scaling of dragger.
+    //! rescale from the cached world matrix, false if the scale was valid.
+    bool updateAutoScale(const SbViewVolume &viewVolume);
 
     void setAxisColors(unsigned long x, unsigned long y,
                        unsigned long z); //!< set the axis colors.
@@ -353,7 +382,23 @@ class SoFCCSysDragger : public SoDragger
     bool isHiddenRotationZ(); //!< is x rotation dragger hidden.
     //@}
 
+    //! draw all handles through one SoFCGizmoShape instead of the catalog
+    //! parts, on by default.
+    void setBatchedRendering(bool on);
+    bool isBatchedRendering() const { return batchedRendering; }
+
+    //! pick the handles with SoFCGizmoShape::pickHandle instead of
+    //! intersecting the catalog geometry, on by default.
+    void setAnalyticPicking(bool on);
+    bool isAnalyticPicking() const { return analyticPicking; }
+
+    //! apply at most one drag step per frame on all child draggers, off by
+    //! default.
+    void setCoalescedMotion(bool on);
+    bool isCoalescedMotion() const { return coalescedMotion; }
+
     void GLRender(SoGLRenderAction *action) override;
+    void rayPick(SoRayPickAction *action) override;
 
   protected:
     SbBool setUpConnections(SbBool onoff, SbBool doitalways = FALSE) override;
@@ -362,15 +407,10 @@ class SoFCCSysDragger : public SoDragger
     static void translationSensorCB(void *f, SoSensor *);
     static void rotationSensorCB(void *f, SoSensor *);
     static void valueChangedCB(void *, SoDragger *d);
-    static void cameraCB(void *data, SoSensor *);
-    static void
-    idleCB(void *data,
-           SoSensor *); //!< scheduled from cameraCB to auto scale dragger.
     static void finishDragCB(void *data, SoDragger *);
 
     SoFieldSensor translationSensor;
     SoFieldSensor rotationSensor;
-    SoFieldSensor cameraSensor;
 
   private:
     // Used to compensate for axis scale in world transformation when doing
@@ -379,6 +419,19 @@ class SoFCCSysDragger : public SoDragger
 
     bool scaleInited{false};
 
+    //! shared with all draggers following the same camera.
+    DraggerAutoScaler *autoScaler{nullptr};
+    DraggerMatrixCache matrixCache{this};
+
+    SoFCGizmoShape *gizmoShape{nullptr};
+    bool batchedRendering{true};
+    bool analyticPicking{true};
+    bool coalescedMotion{false};
+
+    void buildFirstInstance();
+    void syncGizmoShape();
+    void addHandleIntersection(SoRayPickAction *action, int handle,
+                               const SbVec3f &point);
     void updateAxisScale();
 
     using inherited = SoDragger;
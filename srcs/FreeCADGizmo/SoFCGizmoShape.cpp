@@ -0,0 +1,482 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SoFCGizmoShape.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:54:22, October 17, 2026
+ */
+#include "SoFCGizmoShape.h"
+
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SoPrimitiveVertex.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/bundles/SoMaterialBundle.h>
+#include <Inventor/elements/SoGLLazyElement.h>
+#include <Inventor/elements/SoLightModelElement.h>
+#include <Inventor/misc/SoState.h>
+#include <Inventor/system/gl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Gui;
+
+namespace
+{
+constexpr int Segments = 12;
+
+struct GizmoMesh {
+    std::vector<SbVec3f> points;
+    std::vector<uint32_t> indices;
+    // handle h owns the vertices [vertexBegin[h], vertexBegin[h + 1]) and
+    // the indices [indexBegin[h], indexBegin[h + 1])
+    uint32_t vertexBegin[SoFCGizmoShape::HandleCount + 1]{};
+    uint32_t indexBegin[SoFCGizmoShape::HandleCount + 1]{};
+
+    uint32_t add(const SbVec3f &point)
+    {
+        points.push_back(point);
+        return uint32_t(points.size() - 1);
+    }
+
+    void triangle(uint32_t a, uint32_t b, uint32_t c)
+    {
+        indices.insert(indices.end(), {a, b, c});
+    }
+
+    // ring of Segments points around the y axis
+    uint32_t ring(float y, float radius)
+    {
+        uint32_t first = uint32_t(points.size());
+        for (int i = 0; i < Segments; ++i) {
+            float angle = float(2.0 * M_PI) * i / Segments;
+            add(SbVec3f(radius * std::cos(angle), y, radius * std::sin(angle)));
+        }
+        return first;
+    }
+
+    void fan(uint32_t center, uint32_t ringStart)
+    {
+        for (int i = 0; i < Segments; ++i) {
+            triangle(center, ringStart + i, ringStart + (i + 1) % Segments);
+        }
+    }
+
+    void band(uint32_t lower, uint32_t upper, int count)
+    {
+        for (int i = 0; i < count; ++i) {
+            int j = (i + 1) % count;
+            triangle(lower + i, upper + i, upper + j);
+            triangle(lower + i, upper + j, lower + j);
+        }
+    }
+
+    // same leg as TDragger::buildGeometry
+    void translator()
+    {
+        float cylinderHeight = 10.0f;
+        float coneHeight = 2.5f;
+        uint32_t bottom = ring(0.0f, 0.1f);
+        uint32_t top = ring(cylinderHeight, 0.1f);
+        band(bottom, top, Segments);
+        fan(add(SbVec3f(0.0f, 0.0f, 0.0f)), bottom);
+
+        uint32_t base = ring(cylinderHeight, 0.8f);
+        fan(add(SbVec3f(0.0f, cylinderHeight, 0.0f)), base);
+        fan(add(SbVec3f(0.0f, cylinderHeight + coneHeight, 0.0f)), base);
+    }
+
+    // same square as TPlanarDragger::buildGeometry
+    void planarTranslator()
+    {
+        float half = 1.0f;
+        float depth = 0.05f;
+        SbVec3f center(2.15f, 2.15f, 0.0f);
+        uint32_t first = uint32_t(points.size());
+        for (int i = 0; i < 8; ++i) {
+            add(center + SbVec3f(i & 1 ? half : -half, i & 2 ? half : -half,
+                                 i & 4 ? depth : -depth));
+        }
+        static const uint32_t faces[6][4] = {
+            {0, 1, 3, 2}, {4, 6, 7, 5}, {0, 4, 5, 1},
+            {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 5, 7, 3},
+        };
+        for (const auto &face : faces) {
+            triangle(first + face[0], first + face[1], first + face[2]);
+            triangle(first + face[0], first + face[2], first + face[3]);
+        }
+    }
+
+    // same arc and knob as RDragger::buildGeometry, the arc drawn as a thin
+    // tube instead of a wide line to stay in one primitive type
+    void rotator()
+    {
+        float arcRadius = 8.0f;
+        int arcSegments = 15;
+        int tubeSides = 6;
+        uint32_t previous = 0;
+        for (int i = 0; i <= arcSegments; ++i) {
+            float angle = float(M_PI / 2.0) * i / arcSegments;
+            SbVec3f radial(std::cos(angle), std::sin(angle), 0.0f);
+            uint32_t first = uint32_t(points.size());
+            for (int j = 0; j < tubeSides; ++j) {
+                float phi = float(2.0 * M_PI) * j / tubeSides;
+                add(radial * (arcRadius + 0.1f * std::cos(phi)) +
+                    SbVec3f(0.0f, 0.0f, 0.1f * std::sin(phi)));
+            }
+            if (i > 0) {
+                band(previous, first, tubeSides);
+            }
+            previous = first;
+        }
+
+        SbVec3f center(1.0f, 1.0f, 0.0f);
+        center.normalize();
+        center *= arcRadius;
+        float radius = 0.8f;
+        int stacks = Segments / 2;
+        uint32_t south = add(center - SbVec3f(0.0f, radius, 0.0f));
+        uint32_t lower = 0;
+        for (int i = 1; i < stacks; ++i) {
+            float theta = float(M_PI) * i / stacks;
+            uint32_t current = ring(-radius * std::cos(theta),
+                                    radius * std::sin(theta));
+            for (uint32_t k = current; k < current + Segments; ++k) {
+                points[k] += center;
+            }
+            if (i == 1) {
+                fan(south, current);
+            } else {
+                band(lower, current, Segments);
+            }
+            lower = current;
+        }
+        fan(add(center + SbVec3f(0.0f, radius, 0.0f)), lower);
+    }
+};
+
+const GizmoMesh &getMesh()
+{
+    static const GizmoMesh mesh = [] {
+        GizmoMesh result;
+        for (int h = 0; h < SoFCGizmoShape::HandleCount; ++h) {
+            result.vertexBegin[h] = uint32_t(result.points.size());
+            result.indexBegin[h] = uint32_t(result.indices.size());
+            if (h <= SoFCGizmoShape::TranslationZ) {
+                result.translator();
+            } else if (h <= SoFCGizmoShape::PlanarTranslationZX) {
+                result.planarTranslator();
+            } else {
+                result.rotator();
+            }
+
+            SbRotation rotation = SoFCGizmoShape::getHandleRotation(
+                static_cast<SoFCGizmoShape::Handle>(h));
+            for (size_t i = result.vertexBegin[h]; i < result.points.size();
+                 ++i) {
+                rotation.multVec(result.points[i], result.points[i]);
+            }
+        }
+        result.vertexBegin[SoFCGizmoShape::HandleCount] =
+            uint32_t(result.points.size());
+        result.indexBegin[SoFCGizmoShape::HandleCount] =
+            uint32_t(result.indices.size());
+        return result;
+    }();
+    return mesh;
+}
+
+constexpr uint32_t AllHandles = (1u << SoFCGizmoShape::HandleCount) - 1;
+
+// ray parameters of the hit tests, the direction is normalized. A hit keeps
+// the smaller t of the test and the best one so far.
+bool hitSphere(const SbVec3f &origin, const SbVec3f &direction,
+               const SbVec3f &center, float radius, float &t)
+{
+    SbVec3f oc = origin - center;
+    float b = oc.dot(direction);
+    float c = oc.dot(oc) - radius * radius;
+    float h = b * b - c;
+    if (h < 0.0f) {
+        return false;
+    }
+    float hit = -b - std::sqrt(h);
+    if (hit < 0.0f || hit >= t) {
+        return false;
+    }
+    t = hit;
+    return true;
+}
+
+bool hitCapsule(const SbVec3f &origin, const SbVec3f &direction,
+                const SbVec3f &a, const SbVec3f &b, float radius, float &t)
+{
+    SbVec3f ba = b - a;
+    SbVec3f oa = origin - a;
+    float baba = ba.dot(ba);
+    float bard = ba.dot(direction);
+    float baoa = ba.dot(oa);
+    float rdoa = direction.dot(oa);
+    float oaoa = oa.dot(oa);
+    float qa = baba - bard * bard;
+    float qb = baba * rdoa - baoa * bard;
+    float qc = baba * oaoa - baoa * baoa - radius * radius * baba;
+    float h = qb * qb - qa * qc;
+    if (qa > 1e-12f && h >= 0.0f) {
+        float hit = (-qb - std::sqrt(h)) / qa;
+        float y = baoa + hit * bard;
+        if (y > 0.0f && y < baba) {
+            if (hit < 0.0f || hit >= t) {
+                return false;
+            }
+            t = hit;
+            return true;
+        }
+    }
+    // the body was missed or hit beyond the ends, try the caps
+    bool hitA = hitSphere(origin, direction, a, radius, t);
+    bool hitB = hitSphere(origin, direction, b, radius, t);
+    return hitA || hitB;
+}
+
+// square of TPlanarDragger::buildGeometry in the z = 0 plane
+bool hitQuad(const SbVec3f &origin, const SbVec3f &direction, float &t)
+{
+    if (std::fabs(direction[2]) < 1e-12f) {
+        return false;
+    }
+    float hit = -origin[2] / direction[2];
+    if (hit < 0.0f || hit >= t) {
+        return false;
+    }
+    SbVec3f point = origin + direction * hit;
+    if (std::fabs(point[0] - 2.15f) > 1.0f ||
+        std::fabs(point[1] - 2.15f) > 1.0f) {
+        return false;
+    }
+    t = hit;
+    return true;
+}
+
+bool hitTranslator(const SbVec3f &origin, const SbVec3f &direction,
+                   float &t)
+{
+    bool leg = hitCapsule(origin, direction, SbVec3f(0.0f, 0.0f, 0.0f),
+                          SbVec3f(0.0f, 10.0f, 0.0f), 0.1f, t);
+    bool cone = hitCapsule(origin, direction, SbVec3f(0.0f, 10.8f, 0.0f),
+                           SbVec3f(0.0f, 11.7f, 0.0f), 0.8f, t);
+    return leg || cone;
+}
+
+bool hitRotator(const SbVec3f &origin, const SbVec3f &direction, float &t)
+{
+    // the arc follows the 15 segments of the line set, a bit thicker than
+    // drawn to make up for the pick radius coin gives lines
+    float arcRadius = 8.0f;
+    int arcSegments = 15;
+    bool hit = false;
+    SbVec3f previous(arcRadius, 0.0f, 0.0f);
+    for (int i = 1; i <= arcSegments; ++i) {
+        float angle = float(M_PI / 2.0) * i / arcSegments;
+        SbVec3f current(arcRadius * std::cos(angle),
+                        arcRadius * std::sin(angle), 0.0f);
+        hit |= hitCapsule(origin, direction, previous, current, 0.3f, t);
+        previous = current;
+    }
+
+    SbVec3f center(1.0f, 1.0f, 0.0f);
+    center.normalize();
+    hit |= hitSphere(origin, direction, center * arcRadius, 0.8f, t);
+    return hit;
+}
+} // namespace
+
+SO_NODE_SOURCE(SoFCGizmoShape)
+
+size_t SoFCGizmoShape::drawCalls = 0;
+
+void SoFCGizmoShape::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCGizmoShape, SoShape, "Shape");
+}
+
+SoFCGizmoShape::SoFCGizmoShape()
+{
+    SO_NODE_CONSTRUCTOR(SoFCGizmoShape);
+    SO_NODE_ADD_FIELD(handleColor, (SbColor(1.0f, 1.0f, 1.0f)));
+    SO_NODE_ADD_FIELD(visibleHandles, (AllHandles));
+    SO_NODE_ADD_FIELD(activeHandles, (0));
+    SO_NODE_ADD_FIELD(activeColor, (SbColor(1.0f, 1.0f, 0.0f)));
+}
+
+SbRotation SoFCGizmoShape::getHandleRotation(Handle handle)
+{
+    auto angle = static_cast<float>(M_PI / 2.0);
+    SbRotation rotation;
+    switch (handle) {
+        case TranslationX:
+            return SbRotation(SbVec3f(0.0, 0.0, -1.0), angle);
+        case TranslationZ:
+            return SbRotation(SbVec3f(1.0, 0.0, 0.0), angle);
+        case PlanarTranslationYZ:
+            return SbRotation(SbVec3f(0.0, -1.0, 0.0), angle);
+        case PlanarTranslationZX:
+            return SbRotation(SbVec3f(1.0, 0.0, 0.0), angle);
+        case RotationX:
+            rotation = SbRotation(SbVec3f(1.0, 0.0, 0.0), angle);
+            rotation *= SbRotation(SbVec3f(0.0, 0.0, 1.0), angle);
+            return rotation;
+        case RotationY:
+            rotation = SbRotation(SbVec3f(0.0, -1.0, 0.0), angle);
+            rotation *= SbRotation(SbVec3f(0.0, 0.0, -1.0), angle);
+            return rotation;
+        default:
+            return SbRotation::identity();
+    }
+}
+
+int SoFCGizmoShape::pickHandle(const SbLine &line, uint32_t visible,
+                               SbVec3f &point)
+{
+    int picked = -1;
+    float t = std::numeric_limits<float>::max();
+    for (int h = 0; h < HandleCount; ++h) {
+        if (!(visible & (1u << h))) {
+            continue;
+        }
+        // the handles are tested in their own space, rotations keep t
+        SbRotation toHandle =
+            getHandleRotation(static_cast<Handle>(h)).inverse();
+        SbVec3f origin, direction;
+        toHandle.multVec(line.getPosition(), origin);
+        toHandle.multVec(line.getDirection(), direction);
+
+        bool hit = h <= TranslationZ ? hitTranslator(origin, direction, t)
+                   : h <= PlanarTranslationZX
+                       ? hitQuad(origin, direction, t)
+                       : hitRotator(origin, direction, t);
+        if (hit) {
+            picked = h;
+        }
+    }
+    if (picked >= 0) {
+        point = line.getPosition() + line.getDirection() * t;
+    }
+    return picked;
+}
+
+void SoFCGizmoShape::notify(SoNotList *list)
+{
+    buffersValid = false;
+    inherited::notify(list);
+}
+
+void SoFCGizmoShape::updateBuffers()
+{
+    const GizmoMesh &mesh = getMesh();
+    colors.resize(mesh.points.size() * 4);
+    uint32_t visible = visibleHandles.getValue() & AllHandles;
+    uint32_t active = activeHandles.getValue();
+
+    indices.clear();
+    for (int h = 0; h < HandleCount; ++h) {
+        SbColor color = (active & (1u << h))   ? activeColor.getValue()
+                        : h < handleColor.getNum() ? handleColor[h]
+                                                   : SbColor(1.0f, 1.0f, 1.0f);
+        uint8_t rgba[4] = {uint8_t(color[0] * 255.0f + 0.5f),
+                           uint8_t(color[1] * 255.0f + 0.5f),
+                           uint8_t(color[2] * 255.0f + 0.5f), 255};
+        for (uint32_t v = mesh.vertexBegin[h]; v < mesh.vertexBegin[h + 1];
+             ++v) {
+            std::copy(rgba, rgba + 4, colors.begin() + v * 4);
+        }
+
+        if (visible != AllHandles && (visible & (1u << h))) {
+            indices.insert(indices.end(),
+                           mesh.indices.begin() + mesh.indexBegin[h],
+                           mesh.indices.begin() + mesh.indexBegin[h + 1]);
+        }
+    }
+    buffersValid = true;
+}
+
+const std::vector<uint32_t> &SoFCGizmoShape::getIndices() const
+{
+    return (visibleHandles.getValue() & AllHandles) == AllHandles
+               ? getMesh().indices
+               : indices;
+}
+
+void SoFCGizmoShape::GLRender(SoGLRenderAction *action)
+{
+    if (!shouldGLRender(action)) {
+        return;
+    }
+    if (!buffersValid) {
+        updateBuffers();
+    }
+    const auto &drawIndices = getIndices();
+    if (drawIndices.empty()) {
+        return;
+    }
+
+    SoState *state = action->getState();
+    state->push();
+    SoLightModelElement::set(state, this, SoLightModelElement::BASE_COLOR);
+    SoMaterialBundle mb(action);
+    mb.sendFirst();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, getMesh().points.data());
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
+    glDrawElements(GL_TRIANGLES, GLsizei(drawIndices.size()), GL_UNSIGNED_INT,
+                   drawIndices.data());
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    ++drawCalls;
+
+    // the color array left the current gl color behind coin's back
+    SoGLLazyElement::getInstance(state)->reset(state,
+                                               SoLazyElement::DIFFUSE_MASK);
+    state->pop();
+}
+
+void SoFCGizmoShape::computeBBox(SoAction *, SbBox3f &box, SbVec3f &center)
+{
+    const GizmoMesh &mesh = getMesh();
+    uint32_t visible = visibleHandles.getValue();
+    box.makeEmpty();
+    for (int h = 0; h < HandleCount; ++h) {
+        if (!(visible & (1u << h))) {
+            continue;
+        }
+        for (uint32_t v = mesh.vertexBegin[h]; v < mesh.vertexBegin[h + 1];
+             ++v) {
+            box.extendBy(mesh.points[v]);
+        }
+    }
+    if (!box.isEmpty()) {
+        center = box.getCenter();
+    }
+}
+
+void SoFCGizmoShape::generatePrimitives(SoAction *action)
+{
+    if (!buffersValid) {
+        updateBuffers();
+    }
+    const GizmoMesh &mesh = getMesh();
+    const auto &drawIndices = getIndices();
+
+    SoPrimitiveVertex vertex;
+    vertex.setNormal(SbVec3f(0.0f, 0.0f, 1.0f));
+    beginShape(action, TRIANGLES);
+    for (uint32_t index : drawIndices) {
+        vertex.setPoint(mesh.points[index]);
+        shapeVertex(&vertex);
+    }
+    endShape();
+}
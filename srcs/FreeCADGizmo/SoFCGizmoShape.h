@@ -0,0 +1,91 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SoFCGizmoShape.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:54:22, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/SbLine.h>
+#include <Inventor/SbRotation.h>
+#include <Inventor/fields/SoMFColor.h>
+#include <Inventor/fields/SoSFColor.h>
+#include <Inventor/fields/SoSFUInt32.h>
+#include <Inventor/nodes/SoShape.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Gui
+{
+
+/*! @brief All handles of a SoFCCSysDragger in one shape.
+ *
+ * The handle geometry is tessellated once per process into a single vertex
+ * array in dragger space, laid out like the catalog parts of the dragger.
+ * Every instance only keeps a color per vertex and, while some handles are
+ * hidden, its own index list, so the whole gizmo is drawn with one call.
+ * The handles are unlit like the parts they replace.
+ */
+class SoFCGizmoShape : public SoShape
+{
+    using inherited = SoShape;
+
+    SO_NODE_HEADER(SoFCGizmoShape);
+
+  public:
+    enum Handle {
+        TranslationX,
+        TranslationY,
+        TranslationZ,
+        PlanarTranslationXY,
+        PlanarTranslationYZ,
+        PlanarTranslationZX,
+        RotationX,
+        RotationY,
+        RotationZ,
+        HandleCount
+    };
+
+    static void initClass();
+    SoFCGizmoShape();
+
+    SoMFColor handleColor;     //!< one color per handle.
+    SoSFUInt32 visibleHandles; //!< one bit per handle.
+    SoSFUInt32 activeHandles;  //!< one bit per handle, drawn in activeColor.
+    SoSFColor activeColor;
+
+    //! orientation of a handle inside the dragger, shared with the catalog.
+    static SbRotation getHandleRotation(Handle handle);
+    /*! @brief Analytic pick of the visible handles.
+     *
+     * Capsules for the translator legs and the rotator arcs, a quad for the
+     * planar handles and a sphere for the rotator knobs, all in gizmo space.
+     * Returns the nearest handle along line and its hit point, or -1.
+     */
+    static int pickHandle(const SbLine &line, uint32_t visible,
+                          SbVec3f &point);
+
+    static size_t drawCalls; //!< glDrawElements issued by all instances.
+
+  protected:
+    ~SoFCGizmoShape() override = default;
+
+    void GLRender(SoGLRenderAction *action) override;
+    void computeBBox(SoAction *action, SbBox3f &box, SbVec3f &center) override;
+    void generatePrimitives(SoAction *action) override;
+    void notify(SoNotList *list) override;
+
+  private:
+    void updateBuffers();
+    const std::vector<uint32_t> &getIndices() const;
+
+    std::vector<uint8_t> colors; // rgba per vertex
+    std::vector<uint32_t> indices; // visible triangles, empty if all are
+    bool buffersValid{false};
+};
+
+} // namespace Gui
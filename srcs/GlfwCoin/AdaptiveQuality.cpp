@@ -0,0 +1,117 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file AdaptiveQuality.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:15:51, October 17, 2026
+ */
+#include "AdaptiveQuality.h"
+
+#include <Inventor/nodes/SoNode.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace zen
+{
+AdaptiveQuality::AdaptiveQuality() : camera_sensor(CameraCallback, this)
+{
+    // immediate, the callback only sets a flag
+    camera_sensor.setPriority(0);
+}
+
+AdaptiveQuality::~AdaptiveQuality() { camera_sensor.detach(); }
+
+void AdaptiveQuality::SetMode(QualityMode quality_mode, double budget_ms)
+{
+    mode = quality_mode;
+    budget = std::max(budget_ms, 1.0);
+    scale = 1.f;
+    if (mode == QualityMode::Full) {
+        interacting = false;
+    }
+}
+
+void AdaptiveQuality::SetCamera(SoNode *camera)
+{
+    camera_sensor.detach();
+    if (camera) {
+        camera_sensor.attach(camera);
+    }
+}
+
+void AdaptiveQuality::OnInput(const InputEvent &input, double now)
+{
+    switch (input.type) {
+    case InputEvent::Type::Button:
+        if (input.action == GLFW_PRESS) {
+            ++buttons_down;
+        } else if (input.action == GLFW_RELEASE) {
+            // the press went to imgui
+            if (!buttons_down) {
+                return;
+            }
+            --buttons_down;
+        }
+        break;
+    case InputEvent::Type::Move:
+        // hovering is no interaction
+        if (!buttons_down) {
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    last_activity = now;
+}
+
+bool AdaptiveQuality::Update(double now)
+{
+    if (camera_changed) {
+        last_activity = now;
+        camera_changed = false;
+    }
+
+    bool was_interacting = interacting;
+    interacting = mode != QualityMode::Full &&
+                  (buttons_down > 0 ||
+                   (last_activity >= 0.0 && now - last_activity < idle_delay));
+    if (was_interacting && !interacting) {
+        ++refinements;
+        return true;
+    }
+    return false;
+}
+
+void AdaptiveQuality::EndFrame(double frame_ms)
+{
+    if (!interacting || frame_ms <= 0.0) {
+        return;
+    }
+
+    // the resolution cost follows the pixel count, the square of the scale
+    double ratio = budget / frame_ms;
+    double target = mode == QualityMode::Resolution ? scale * std::sqrt(ratio)
+                                                    : scale * ratio;
+    // halfway per frame against the noise of single frames, in 1/16 steps so
+    // the scaled target and the shape caches are not rebuilt every frame
+    double next = std::round((scale + 0.5 * (target - scale)) * 16.0) / 16.0;
+    scale = std::clamp(float(next), min_scale, 1.f);
+}
+
+double AdaptiveQuality::GetTimeout(double now) const
+{
+    if (!interacting || buttons_down > 0) {
+        return -1.0;
+    }
+    return std::max(0.0, last_activity + idle_delay - now);
+}
+
+void AdaptiveQuality::CameraCallback(void *user, SoSensor *)
+{
+    static_cast<AdaptiveQuality *>(user)->camera_changed = true;
+}
+
+} // namespace zen
@@ -0,0 +1,75 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file AdaptiveQuality.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:15:51, October 17, 2026
+ */
+#pragma once
+
+#include <CoinApp.h>
+
+#include "EventCallback.h"
+
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <cstddef>
+
+class SoNode;
+
+namespace zen
+{
+
+/// picks the quality scale of the frames drawn while the user navigates or
+/// drags. The scale follows the measured frame time towards the budget and
+/// is kept for the next interaction. An interaction lasts while a mouse
+/// button is held and until idle_delay passed after the last input or
+/// camera change, then one frame is drawn at full quality.
+class AdaptiveQuality
+{
+  public:
+    AdaptiveQuality();
+    ~AdaptiveQuality();
+
+    void SetMode(QualityMode quality_mode, double budget_ms);
+    QualityMode GetMode() const { return mode; }
+    double GetBudget() const { return budget; }
+
+    /// camera changes count as interaction, e.g. the spin of the examiner
+    /// after the button was released
+    void SetCamera(SoNode *camera);
+    void OnInput(const InputEvent &input, double now);
+
+    /// true once when an interaction ended, the caller draws the refinement
+    /// frame
+    bool Update(double now);
+    /// time of the frame drawn after the last Update, without the time spent
+    /// waiting for events
+    void EndFrame(double frame_ms);
+
+    bool IsInteracting() const { return interacting; }
+    /// 1 outside of an interaction
+    float GetScale() const { return interacting ? scale : 1.f; }
+    /// seconds until Update ends the interaction, negative if it waits for
+    /// a button release or there is none
+    double GetTimeout(double now) const;
+
+    float min_scale{0.25f};
+    double idle_delay{0.15}; ///< seconds
+    size_t refinements{0};
+
+  private:
+    static void CameraCallback(void *user, SoSensor *sensor);
+
+    QualityMode mode{QualityMode::Full};
+    double budget{33.3};
+    SoNodeSensor camera_sensor;
+    bool camera_changed{false};
+    int buttons_down{0};
+    double last_activity{-1.0};
+    bool interacting{false};
+    float scale{1.f};
+};
+
+} // namespace zen
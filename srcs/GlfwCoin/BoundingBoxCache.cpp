@@ -0,0 +1,65 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file BoundingBoxCache.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:43:37, October 17, 2026
+ */
+#include "BoundingBoxCache.h"
+
+#include <Inventor/nodes/SoNode.h>
+
+namespace zen
+{
+BoundingBoxCache::BoundingBoxCache()
+    : sensor(SensorCallback, this), action(SbViewportRegion())
+{
+    // immediate, the trigger node is only known while the notification
+    // runs. The callback only sets a flag.
+    sensor.setPriority(0);
+}
+
+BoundingBoxCache::~BoundingBoxCache() { sensor.detach(); }
+
+void BoundingBoxCache::SetSceneGraph(SoNode *scene_root, SoNode *ignored_node)
+{
+    sensor.detach();
+    root = scene_root;
+    ignored = ignored_node;
+    if (root) {
+        sensor.attach(root);
+    }
+    box.makeEmpty();
+    dirty = true;
+}
+
+const SbXfBox3f &BoundingBoxCache::GetXfBox(const SbViewportRegion &viewport)
+{
+    // screen space shapes like SoText2 depend on the viewport
+    if (!(viewport == last_viewport)) {
+        last_viewport = viewport;
+        dirty = true;
+    }
+
+    if (dirty && root) {
+        action.setViewportRegion(viewport);
+        action.apply(root);
+        box = action.getXfBoundingBox();
+        dirty = false;
+        ++recomputes;
+    }
+    return box;
+}
+
+void BoundingBoxCache::SensorCallback(void *user, SoSensor *sensor)
+{
+    auto self = static_cast<BoundingBoxCache *>(user);
+    auto node_sensor = static_cast<SoNodeSensor *>(sensor);
+    if (self->ignored && node_sensor->getTriggerNode() == self->ignored) {
+        return;
+    }
+    self->dirty = true;
+}
+
+} // namespace zen
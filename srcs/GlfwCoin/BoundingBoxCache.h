@@ -0,0 +1,60 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file BoundingBoxCache.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:43:37, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SbXfBox3f.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <cstddef>
+
+class SoNode;
+
+namespace zen
+{
+
+/// bounding box of a whole scene graph, recomputed only after something
+/// below the root notified. The recomputation itself goes through the
+/// bounding box caches coin keeps per separator, so only the separators on
+/// the path to a change get traversed again.
+class BoundingBoxCache
+{
+  public:
+    BoundingBoxCache();
+    ~BoundingBoxCache();
+
+    /// notifications of ignored, usually the camera, keep the box valid
+    void SetSceneGraph(SoNode *root, SoNode *ignored = nullptr);
+    void Invalidate() { dirty = true; }
+    bool IsDirty() const { return dirty; }
+
+    const SbXfBox3f &GetXfBox(const SbViewportRegion &viewport);
+    SbBox3f GetBox(const SbViewportRegion &viewport)
+    {
+        return GetXfBox(viewport).project();
+    }
+
+    /// number of traversals so far
+    size_t recomputes{0};
+
+  private:
+    static void SensorCallback(void *user, SoSensor *sensor);
+
+    SoNode *root{nullptr};
+    SoNode *ignored{nullptr};
+    SoNodeSensor sensor;
+    SoGetBoundingBoxAction action;
+    SbViewportRegion last_viewport;
+    SbXfBox3f box;
+    bool dirty{true};
+};
+
+} // namespace zen
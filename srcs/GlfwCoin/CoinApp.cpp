@@ -36,12 +36,21 @@
 
 namespace zen
 {
-CoinApp::CoinApp(const char *title) : impl(new CoinAppImpl)
+CoinApp::CoinApp(const char *title, Backend backend) : impl(new CoinAppImpl)
 {
+    impl->backend = backend;
+
     glfwSetErrorCallback([](int error, const char *description) {
         SPDLOG_ERROR("{}:{}", error, description);
     });
 
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4)
+    if (backend == Backend::Offscreen) {
+        // no X11/Wayland/Win32 connection, the context comes from osmesa/egl
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+#endif
+
     if (!glfwInit()) {
         throw std::runtime_error("Failed to initialize GLFW");
     }
@@ -49,7 +58,18 @@ CoinApp::CoinApp(const char *title) : impl(new CoinAppImpl)
     glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
     // glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
 
-    impl->window = glfwCreateWindow(1'920, 1'120, title, NULL, NULL);
+    if (backend == Backend::Offscreen) {
+        // the window only owns the context, frames go to an offscreen target
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        impl->window = glfwCreateWindow(64, 64, title, NULL, NULL);
+        if (!impl->window) {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+            impl->window = glfwCreateWindow(64, 64, title, NULL, NULL);
+        }
+    } else {
+        impl->window = glfwCreateWindow(1'920, 1'120, title, NULL, NULL);
+    }
     if (!impl->window) {
         glfwTerminate();
         throw std::runtime_error("Failed to create GLFW window");
@@ -72,94 +92,236 @@ CoinApp::~CoinApp()
     glfwTerminate();
 }
 
+bool CoinApp::StartRecording(const std::string &path)
+{
+    auto [width, height] = impl->GetWindowSize();
+    return impl->recorder.Open(path, width, height,
+                               CameraState::FromCamera(impl->camera),
+                               glfwGetTime());
+}
+
+void CoinApp::StopRecording() { impl->recorder.Close(); }
+
+bool CoinApp::StartReplay(const std::string &path, const ReplayOptions &options)
+{
+    auto &replayer = impl->replayer;
+    if (!replayer.Open(path)) {
+        return false;
+    }
+
+    impl->replay_options = options;
+    impl->replay_timings.clear();
+    impl->replay_frame_pending = false;
+    impl->replay_start = glfwGetTime();
+
+    replayer.dispatching = true;
+    framebufferSizeCallback(impl->window, replayer.width, replayer.height);
+    replayer.camera.ApplyTo(impl->camera);
+    replayer.dispatching = false;
+
+    spdlog::info("replaying {} input records from {}", replayer.records.size(),
+                 path);
+    return true;
+}
+
+bool CoinApp::IsReplaying() const { return impl->replayer.IsActive(); }
+
 void CoinApp::Run()
 {
+    if (impl->backend == Backend::Offscreen) {
+        throw std::runtime_error("Run is not available without a window, "
+                                 "use RenderToBuffer instead");
+    }
+
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_LIGHTING);
 
     impl->ImGuiInit();
 
-    while (!glfwWindowShouldClose(impl->window)) {
-        glfwPollEvents();
-        impl->UpdateViewport();
-
-        impl->ImGuiNewFrame();
-
-        impl->IdleCallback();
-        impl->Render();
+    impl->RequestRedraw();
 
-        impl->ImGuiDraw();
-        impl->ImGuiRender();
-        glfwSwapBuffers(impl->window);
+    auto &profiler = impl->profiler;
+    while (!glfwWindowShouldClose(impl->window)) {
+        // the time spent sleeping for input is no part of a frame
+        impl->WaitEvents();
+        profiler.BeginFrame();
+        {
+            ScopedFramePhase phase(profiler, FramePhase::Events);
+            // nothing traverses the scene graph here, safe to swap it
+            impl->PollSceneLoader();
+            impl->ReplayInput();
+            impl->UpdateViewport();
+        }
+        {
+            ScopedFramePhase phase(profiler, FramePhase::Input);
+            impl->ProcessInput();
+        }
+        {
+            ScopedFramePhase phase(profiler, FramePhase::Commands);
+            impl->commands.Drain();
+        }
+        impl->UpdateQuality();
+        if (!impl->BeginFrame()) {
+            continue;
+        }
+        {
+            // once per drawn frame, the budget is one of a frame
+            ScopedFramePhase phase(profiler, FramePhase::Idle);
+            impl->ProcessFrameSensors();
+        }
+        {
+            ScopedFramePhase phase(profiler, FramePhase::ImGuiDraw);
+            impl->ImGuiNewFrame();
+        }
+        {
+            ScopedFramePhase phase(profiler, FramePhase::Render);
+            impl->Render();
+        }
+        {
+            ScopedFramePhase phase(profiler, FramePhase::ImGuiDraw);
+            impl->ImGuiDraw();
+        }
+        {
+            ScopedFramePhase phase(profiler, FramePhase::ImGuiRender);
+            impl->ImGuiRender();
+        }
+        {
+            ScopedFramePhase phase(profiler, FramePhase::SwapBuffers);
+            glfwSwapBuffers(impl->window);
+        }
+        profiler.EndFrame();
+        impl->FinishFrame();
     }
 
     impl->ImGuiDestroy();
 }
 
-void CoinApp::SetSceneGraph(SoNode *scene)
+bool CoinApp::RenderToBuffer(int width, int height, unsigned char *rgba,
+                             float *depth)
 {
-    if (impl->root) {
-        impl->root->unref();
+    if (width <= 0 || height <= 0) {
+        return false;
     }
+    return impl->RenderOffscreen(width, height, rgba, depth);
+}
 
-    impl->root = new SoSeparator;
-    impl->root->ref();
+void CoinApp::SetSceneGraph(SoNode *scene) { impl->SetSceneGraph(scene); }
 
-    impl->camera = nullptr;
-    impl->gizmo_transform = nullptr;
+bool CoinApp::LoadSceneAsync(const std::string &path)
+{
+    return impl->scene_loader.Start(path);
+}
 
-    auto root = impl->root;
+void CoinApp::SetSceneCacheDirectory(const std::string &directory)
+{
+    impl->scene_loader.cache_directory = directory;
+}
 
-    if (auto camera = SearchForCamera(root)) {
-        impl->camera = camera;
-    } else {
-        SoPerspectiveCamera *pcam = new SoPerspectiveCamera;
-        pcam->heightAngle = glm::radians(45.f);
-        pcam->nearDistance = 0.01f;
-        pcam->farDistance = 1000.0f;
-        pcam->position = SbVec3f(0, 0, 10);
-        pcam->focalDistance = 10.0f;
-        pcam->pointAt(SbVec3f(0, 0, 0), SbVec3f(0, 1, 0));
-        impl->camera = pcam;
-        root->addChild(pcam);
-    }
+void CoinApp::SetImGuiCallback(std::function<void()> callback)
+{
+    impl->imGuiCallback = std::move(callback);
+}
+
+size_t CoinApp::AddUiHook(SoNode *node, std::function<void()> hook)
+{
+    impl->RequestRedraw();
+    return impl->ui_hooks.Add(node, std::move(hook));
+}
+
+void CoinApp::RemoveUiHook(size_t id)
+{
+    impl->ui_hooks.Remove(id);
+    impl->RequestRedraw();
+}
+
+void CoinApp::Post(std::function<void()> command)
+{
+    impl->PostCommand(std::move(command));
+}
 
-    SoDirectionalLight *light = new SoDirectionalLight;
-    light->direction = SbVec3f(0, 0, -1);
+void CoinApp::PostTranslation(SoTransform *transform,
+                              const SbVec3f &translation)
+{
+    impl->PostCommand(SetTranslationCommand{transform, translation});
+}
+
+void CoinApp::PostRotation(SoTransform *transform, const SbRotation &rotation)
+{
+    impl->PostCommand(SetRotationCommand{transform, rotation});
+}
 
-    root->addChild(light);
+void CoinApp::PostValues(SoMFVec3f *field, std::vector<SbVec3f> values)
+{
+    impl->PostCommand(SetValuesCommand{field, std::move(values)});
+}
+
+CommandQueueStats CoinApp::GetCommandQueueStats() const
+{
+    auto stats = impl->commands.stats;
+    stats.depth = impl->commands.GetDepth();
+    stats.peak_depth = impl->commands.GetPeakDepth();
+    return stats;
+}
+
+void CoinApp::SetGizmoTransform(SoTransform *transform)
+{
+    impl->gizmo_transform = transform;
+    impl->RequestRedraw();
+}
 
-    root->addChild(scene);
+void CoinApp::AddDynamicLayer(SoNode *layer)
+{
+    impl->dynamic_layers->addChild(layer);
+}
 
-    // disable depth test for imgui
-    // auto sodepthBuffer = new SoDepthBuffer;
-    // sodepthBuffer->test = false;
-    // root->addChild(sodepthBuffer);
+void CoinApp::RemoveDynamicLayer(SoNode *layer)
+{
+    int index = impl->dynamic_layers->findChild(layer);
+    if (index >= 0) {
+        impl->dynamic_layers->removeChild(index);
+    }
+}
 
-    auto socb = new SoCallback;
-    socb->setCallback(SoCallbackImGuiEventHandle, impl);
-    root->addChild(socb);
+void CoinApp::SetStaticLayerCaching(bool enable)
+{
+    impl->static_layer_caching = enable;
+    if (!enable) {
+        // the image would be stale once caching is back on
+        impl->static_layer.Release();
+    }
+    impl->RequestRedraw();
+}
 
-    // super imposition doesn't get handle event action
-    // impl->renderManager->addSuperimposition(socb);
+void CoinApp::SetRenderMode(RenderMode mode)
+{
+    impl->render_mode = mode;
+    impl->RequestRedraw();
+}
 
-    impl->render_manager->setSceneGraph(root);
-    impl->render_manager->setCamera(impl->camera);
+void CoinApp::SetAdaptiveQuality(QualityMode mode, double budget_ms)
+{
+    impl->quality.SetMode(mode, budget_ms);
+    impl->RequestRedraw();
+}
 
-    impl->event_manager->setSceneGraph(root);
-    impl->event_manager->setCamera(impl->camera);
+void CoinApp::SetMaxFrameRate(double fps) { impl->max_frame_rate = fps; }
 
-    impl->camera->viewAll(root, impl->render_manager->getViewportRegion());
+void CoinApp::SetSensorBudget(double milliseconds)
+{
+    impl->sensor_pump.budget_ms = milliseconds;
 }
 
-void CoinApp::SetImGuiCallback(std::function<void()> callback)
+void CoinApp::RequestRedraw() { impl->RequestRedraw(); }
+
+void CoinApp::ShowFrameTimings(bool show)
 {
-    impl->imGuiCallback = std::move(callback);
+    impl->show_frame_timings = show;
+    impl->RequestRedraw();
 }
 
-void CoinApp::SetGizmoTransform(SoTransform *transform)
+std::string CoinApp::DumpFrameTimings(size_t frames) const
 {
-    impl->gizmo_transform = transform;
+    return impl->profiler.ToJson(frames);
 }
 
 } // namespace zen
\ No newline at end of file
@@ -0,0 +1,581 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file CoinAppBenchmark.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:26:37, October 17, 2026
+ */
+#include "BoundingBoxCache.h"
+#include "CoinApp.h"
+#include "SceneInput.h"
+#include "SensorPump.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/SoInput.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
+#include <Inventor/elements/SoCacheElement.h>
+#include <Inventor/nodes/SoCallback.h>
+#include <Inventor/nodes/SoCone.h>
+#include <Inventor/nodes/SoMaterial.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoTransform.h>
+#include <Inventor/nodes/SoTranslation.h>
+#include <Inventor/sensors/SoIdleSensor.h>
+
+#include <GLFW/glfw3.h>
+
+#include <imgui.h>
+
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <format>
+#include <map>
+#include <memory>
+#include <print>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+SoSeparator *CreateGridScene(int count)
+{
+    auto scene = new SoSeparator;
+    auto mat = new SoMaterial;
+    mat->diffuseColor.setValue(1.0, 0.0, 0.0);
+    scene->addChild(mat);
+
+    for (int i = 0; i < count; ++i) {
+        for (int j = 0; j < count; ++j) {
+            auto sep = new SoSeparator;
+            auto trans = new SoTranslation;
+            trans->translation.setValue(3.f * i, 3.f * j, 0.f);
+            sep->addChild(trans);
+            sep->addChild(new SoCone);
+            scene->addChild(sep);
+        }
+    }
+    return scene;
+}
+
+std::string ProgramPath;
+
+size_t PeakResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return size_t(usage.ru_maxrss);
+#else
+    return size_t(usage.ru_maxrss) * 1'024;
+#endif
+#endif
+}
+
+// usage: CoinAppBenchmark generate <file.iv> [megabytes]
+// writes an ascii scene of indexed face sets, compress it with gzip or zstd
+// to benchmark the decompressing path
+int BenchmarkGenerate(const std::vector<std::string> &args)
+{
+    if (args.empty()) {
+        spdlog::error("usage: generate <file.iv> [megabytes]");
+        return EXIT_FAILURE;
+    }
+    size_t target = (args.size() > 1 ? std::stoull(args[1]) : 2'048) << 20;
+
+    std::ofstream out(args[0], std::ios::binary);
+    if (!out) {
+        spdlog::error("failed to open {}", args[0]);
+        return EXIT_FAILURE;
+    }
+
+    out << "#Inventor V2.1 ascii\n\nSeparator {\n";
+    std::string block;
+    size_t written = 0;
+    for (int i = 0; written < target; ++i) {
+        // a 16x16 height field per block
+        constexpr int N = 16;
+        block = "  Separator {\n    Translation { translation ";
+        block += std::format("{} {} 0 }}\n", (i % 256) * N, (i / 256) * N);
+        block += "    Coordinate3 { point [\n";
+        for (int y = 0; y < N; ++y) {
+            for (int x = 0; x < N; ++x) {
+                block += std::format("      {} {} {:.4f},\n", x, y,
+                                     0.25f * float((x * 7 + y * 13 + i) % 17));
+            }
+        }
+        block += "    ] }\n    IndexedFaceSet { coordIndex [\n";
+        for (int y = 0; y + 1 < N; ++y) {
+            for (int x = 0; x + 1 < N; ++x) {
+                int k = y * N + x;
+                block += std::format("      {}, {}, {}, {}, -1,\n", k, k + 1,
+                                     k + N + 1, k + N);
+            }
+        }
+        block += "    ] }\n  }\n";
+        out << block;
+        written += block.size();
+    }
+    out << "}\n";
+
+    std::println("wrote {} MiB to {}", written >> 20, args[0]);
+    return EXIT_SUCCESS;
+}
+
+// usage: CoinAppBenchmark load-one <readall|buffered|mapped|auto> <file>
+// reads the scene once in this process and reports wall time and peak RSS
+int BenchmarkLoadOne(const std::vector<std::string> &args)
+{
+    if (args.size() < 2) {
+        spdlog::error("usage: load-one <readall|buffered|mapped|auto> <file>");
+        return EXIT_FAILURE;
+    }
+    const std::string &method = args[0];
+    const std::string &path = args[1];
+
+    SoDB::init();
+    size_t baseline = PeakResidentBytes();
+
+    auto start = std::chrono::steady_clock::now();
+    SoSeparator *root = nullptr;
+    if (method == "readall") {
+        // the plain coin path for reference
+        SoInput input;
+        if (input.openFile(path.c_str())) {
+            root = SoDB::readAll(&input);
+        }
+    } else if (method == "buffered") {
+        root = zen::ReadScene(path, zen::SceneInputMethod::Buffered);
+    } else if (method == "mapped") {
+        root = zen::ReadScene(path, zen::SceneInputMethod::Mapped);
+    } else if (method == "auto") {
+        root = zen::ReadScene(path, zen::SceneInputMethod::Auto);
+    } else {
+        spdlog::error("unknown load method: {}", method);
+        return EXIT_FAILURE;
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    if (!root) {
+        spdlog::error("{}: failed to read {}", method, path);
+        return EXIT_FAILURE;
+    }
+    root->ref();
+    std::println("{:>8}: {:8.3f}s, peak rss {:7.1f} MiB (+{:.1f} MiB), {} "
+                 "children",
+                 method, elapsed.count(),
+                 double(PeakResidentBytes()) / (1 << 20),
+                 double(PeakResidentBytes() - baseline) / (1 << 20),
+                 root->getNumChildren());
+    root->unref();
+    return EXIT_SUCCESS;
+}
+
+// usage: CoinAppBenchmark load <file> [methods...]
+// runs load-one per method in a fresh process, so every method starts with
+// the same peak RSS. Drop the page cache in between for cold numbers.
+int BenchmarkLoad(const std::vector<std::string> &args)
+{
+    if (args.empty()) {
+        spdlog::error("usage: load <file> [readall|buffered|mapped|auto...]");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> methods(args.begin() + 1, args.end());
+    if (methods.empty()) {
+        methods = {"readall", "buffered", "auto"};
+    }
+
+    int status = EXIT_SUCCESS;
+    for (const auto &method : methods) {
+        auto command =
+            std::format("\"{}\" load-one {} \"{}\"", ProgramPath, method,
+                        args[0]);
+        std::fflush(stdout);
+        if (std::system(command.c_str()) != 0) {
+            status = EXIT_FAILURE;
+        }
+    }
+    return status;
+}
+
+// usage: CoinAppBenchmark bbox [grid size] [frames]
+// per-frame bounding box cost of a full SoGetBoundingBoxAction against the
+// cache, once with a static scene and once with one transform moving
+int BenchmarkBoundingBox(const std::vector<std::string> &args)
+{
+    int count = args.size() > 0 ? std::stoi(args[0]) : 100;
+    int frames = args.size() > 1 ? std::stoi(args[1]) : 1'000;
+
+    SoDB::init();
+    auto scene = CreateGridScene(count);
+    scene->ref();
+    // a separator of the grid to move around
+    auto moved = static_cast<SoSeparator *>(scene->getChild(1));
+    auto translation = static_cast<SoTranslation *>(moved->getChild(0));
+
+    SbViewportRegion viewport(1'920, 1'080);
+    auto measure = [&](const char *label, auto &&frame) {
+        frame(0); // warm up the separator caches
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 1; i <= frames; ++i) {
+            frame(i);
+        }
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::println("{:>24}: {:8.4f} ms/frame", label,
+                     elapsed.count() / frames);
+    };
+
+    SoGetBoundingBoxAction action(viewport);
+    zen::BoundingBoxCache cache;
+    cache.SetSceneGraph(scene);
+
+    std::println("{} separators, {} frames", count * count, frames);
+    measure("action, static", [&](int) { action.apply(scene); });
+    measure("cache, static", [&](int) { cache.GetXfBox(viewport); });
+    measure("action, one moving", [&](int i) {
+        translation->translation.setValue(0.f, 0.f, 0.01f * i);
+        action.apply(scene);
+    });
+    measure("cache, one moving", [&](int i) {
+        translation->translation.setValue(0.f, 0.f, 0.01f * i);
+        cache.GetXfBox(viewport);
+    });
+    std::println("cache traversals: {}", cache.recomputes);
+
+    scene->unref();
+    return EXIT_SUCCESS;
+}
+
+// usage: CoinAppBenchmark sensors [chains] [depth] [work us] [budget ms]
+// idle sensors that reschedule themselves depth times with some busy work
+// each, like engines feeding sensors after a bulk edit. Drains them through
+// the sensor pump with and without a budget.
+int BenchmarkSensors(const std::vector<std::string> &args)
+{
+    int chains = args.size() > 0 ? std::stoi(args[0]) : 500;
+    int depth = args.size() > 1 ? std::stoi(args[1]) : 16;
+    int work_us = args.size() > 2 ? std::stoi(args[2]) : 20;
+    double budget = args.size() > 3 ? std::stod(args[3]) : 8.0;
+
+    SoDB::init();
+
+    struct Chain {
+        SoIdleSensor sensor;
+        int remaining{0};
+        std::chrono::microseconds work;
+    };
+    auto step = [](void *data, SoSensor *) {
+        auto chain = static_cast<Chain *>(data);
+        auto until = std::chrono::steady_clock::now() + chain->work;
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        if (--chain->remaining > 0) {
+            chain->sensor.schedule();
+        }
+    };
+
+    std::println("{} chains of {} sensors, {} us each", chains, depth,
+                 work_us);
+    for (double budget_ms : {0.0, budget}) {
+        std::vector<std::unique_ptr<Chain>> pending;
+        for (int i = 0; i < chains; ++i) {
+            auto chain = std::make_unique<Chain>();
+            chain->sensor.setFunction(step);
+            chain->sensor.setData(chain.get());
+            chain->remaining = depth;
+            chain->work = std::chrono::microseconds(work_us);
+            chain->sensor.schedule();
+            pending.push_back(std::move(chain));
+        }
+
+        zen::SensorPump pump;
+        pump.budget_ms = budget_ms;
+        int frames = 0;
+        double longest = 0.0;
+        double total = 0.0;
+        while (SoDB::getSensorManager()->isDelaySensorPending()) {
+            pump.Process();
+            ++frames;
+            longest = std::max(longest, pump.stats.milliseconds);
+            total += pump.stats.milliseconds;
+        }
+        std::println("budget {:5.1f} ms: {:4} frames, longest {:8.3f} ms, "
+                     "total {:8.3f} ms, {} starved",
+                     budget_ms, frames, longest, total, pump.starved_frames);
+    }
+    return EXIT_SUCCESS;
+}
+
+// usage: CoinAppBenchmark commands [producers] [grid size] [frames]
+// worker threads post translations for every separator of the grid as fast
+// as they can while the offscreen backend renders, reports the drain cost
+int BenchmarkCommands(const std::vector<std::string> &args)
+{
+    int producers = args.size() > 0 ? std::stoi(args[0]) : 4;
+    int count = args.size() > 1 ? std::stoi(args[1]) : 32;
+    int frames = args.size() > 2 ? std::stoi(args[2]) : 200;
+
+    zen::CoinApp app("CoinAppBenchmark", zen::Backend::Offscreen);
+    auto scene = CreateGridScene(count);
+    app.SetSceneGraph(scene);
+
+    // SoTranslation has no typed command, give every separator a transform
+    std::vector<SoTransform *> transforms;
+    for (int i = 1; i < scene->getNumChildren(); ++i) {
+        auto sep = static_cast<SoSeparator *>(scene->getChild(i));
+        auto transform = new SoTransform;
+        sep->insertChild(transform, 0);
+        transforms.push_back(transform);
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<size_t> posted{0};
+    std::vector<std::thread> workers;
+    for (int p = 0; p < producers; ++p) {
+        workers.emplace_back([&, p] {
+            for (size_t step = 0; running.load(); ++step) {
+                for (size_t i = p; i < transforms.size(); i += producers) {
+                    app.PostTranslation(transforms[i],
+                                        SbVec3f(0.f, 0.f, 0.001f * step));
+                }
+                posted += transforms.size() / producers;
+                // about one pose per transform and frame
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        });
+    }
+
+    constexpr int Width = 640;
+    constexpr int Height = 480;
+    double drain = 0.0;
+    double longest = 0.0;
+    size_t drained = 0;
+    for (int i = 0; i < frames; ++i) {
+        if (!app.RenderToBuffer(Width, Height, nullptr)) {
+            spdlog::error("offscreen rendering is not available");
+            running = false;
+            break;
+        }
+        auto stats = app.GetCommandQueueStats();
+        drain += stats.drain_ms;
+        longest = std::max(longest, stats.drain_ms);
+        drained += stats.drained;
+    }
+    running = false;
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    auto stats = app.GetCommandQueueStats();
+    std::println("{} producers, {} transforms, {} frames", producers,
+                 transforms.size(), frames);
+    std::println("posted {}, drained {}, left {}, peak depth {}",
+                 posted.load(), drained, stats.depth, stats.peak_depth);
+    std::println("drain avg {:.4f} ms, longest {:.4f} ms", drain / frames,
+                 longest);
+    return EXIT_SUCCESS;
+}
+
+// usage: CoinAppBenchmark offscreen [width] [height] [frames]
+int BenchmarkOffscreen(const std::vector<std::string> &args)
+{
+    int width = args.size() > 0 ? std::stoi(args[0]) : 1'920;
+    int height = args.size() > 1 ? std::stoi(args[1]) : 1'080;
+    int frames = args.size() > 2 ? std::stoi(args[2]) : 200;
+
+    zen::CoinApp app("CoinAppBenchmark", zen::Backend::Offscreen);
+    app.SetSceneGraph(CreateGridScene(32));
+
+    std::vector<unsigned char> rgba(4 * size_t(width) * height);
+    std::vector<float> depth(size_t(width) * height);
+
+    // warm up, the first frame builds the display lists and textures
+    if (!app.RenderToBuffer(width, height, rgba.data(), depth.data())) {
+        spdlog::error("offscreen rendering is not available");
+        return EXIT_FAILURE;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        app.RenderToBuffer(width, height, rgba.data(), depth.data());
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::println("offscreen {}x{}: {} frames in {:.3f}s, {:.1f} images/s",
+                 width, height, frames, elapsed.count(),
+                 frames / elapsed.count());
+    return EXIT_SUCCESS;
+}
+
+// usage: CoinAppBenchmark layers [grid size] [frames] [width] [height]
+// offscreen frame time of a grid scene with one cone moving in a dynamic
+// layer, with the cached scene image and with the scene rendered every frame
+int BenchmarkLayers(const std::vector<std::string> &args)
+{
+    int count = args.size() > 0 ? std::stoi(args[0]) : 100;
+    int frames = args.size() > 1 ? std::stoi(args[1]) : 200;
+    int width = args.size() > 2 ? std::stoi(args[2]) : 1'920;
+    int height = args.size() > 3 ? std::stoi(args[3]) : 1'080;
+
+    zen::CoinApp app("CoinAppBenchmark", zen::Backend::Offscreen);
+    app.SetSceneGraph(CreateGridScene(count));
+
+    auto layer = new SoSeparator;
+    auto translation = new SoTranslation;
+    layer->addChild(translation);
+    layer->addChild(new SoCone);
+    app.AddDynamicLayer(layer);
+
+    std::println("{} separators, {} frames at {}x{}", count * count, frames,
+                 width, height);
+    for (bool caching : {false, true}) {
+        app.SetStaticLayerCaching(caching);
+        // warm up, the first frame builds the display lists and the image
+        if (!app.RenderToBuffer(width, height, nullptr)) {
+            spdlog::error("offscreen rendering is not available");
+            return EXIT_FAILURE;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; ++i) {
+            translation->translation.setValue(0.01f * i, 0.f, 0.f);
+            app.RenderToBuffer(width, height, nullptr);
+        }
+        glFinish();
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::println("{:>24}: {:8.4f} ms/frame",
+                     caching ? "cached scene" : "full scene",
+                     elapsed.count() / frames);
+    }
+    return EXIT_SUCCESS;
+}
+
+// usage: CoinAppBenchmark ui [grid size] [frames]
+// frame time of the window loop on a cached grid scene without a panel, with
+// a panel drawn from a SoCallback in the scene that has to invalidate the
+// render caches, and with the same panel as a ui hook
+int BenchmarkUi(const std::vector<std::string> &args)
+{
+    int count = args.size() > 0 ? std::stoi(args[0]) : 100;
+    int frames = args.size() > 1 ? std::stoi(args[1]) : 500;
+    constexpr int Warmup = 10;
+
+    enum class Panel { None, SceneCallback, UiHook };
+    const std::pair<Panel, const char *> variants[] = {
+        {Panel::None, "no panel"},
+        {Panel::SceneCallback, "scene callback panel"},
+        {Panel::UiHook, "ui hook panel"},
+    };
+
+    std::println("{} separators, {} frames", count * count, frames);
+    for (auto [panel, label] : variants) {
+        zen::CoinApp app("CoinAppBenchmark");
+        auto scene = CreateGridScene(count);
+        auto cone = static_cast<SoCone *>(
+            static_cast<SoSeparator *>(scene->getChild(1))->getChild(1));
+
+        std::function<void()> draw = [cone] {
+            ImGui::Begin("Cone");
+            float height = cone->height.getValue();
+            if (ImGui::SliderFloat("Height", &height, 1.f, 10.0f)) {
+                cone->height.setValue(height);
+            }
+            ImGui::End();
+        };
+
+        if (panel == Panel::SceneCallback) {
+            auto callback = new SoCallback;
+            callback->setCallback(
+                [](void *data, SoAction *action) {
+                    if (action->isOfType(SoGLRenderAction::getClassTypeId())) {
+                        SoCacheElement::invalidate(action->getState());
+                        (*static_cast<std::function<void()> *>(data))();
+                    }
+                },
+                &draw);
+            scene->addChild(callback);
+        }
+        app.SetSceneGraph(scene);
+        if (panel == Panel::UiHook) {
+            app.AddUiHook(cone, draw);
+        }
+
+        int frame = 0;
+        auto start = std::chrono::steady_clock::now();
+        app.SetImGuiCallback([&] {
+            if (frame == 0) {
+                glfwSwapInterval(0);
+            }
+            if (frame == Warmup) {
+                start = std::chrono::steady_clock::now();
+            }
+            if (++frame == Warmup + frames) {
+                glfwSetWindowShouldClose(glfwGetCurrentContext(), GLFW_TRUE);
+            }
+        });
+        app.Run();
+
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::println("{:>24}: {:8.4f} ms/frame", label,
+                     elapsed.count() / frames);
+    }
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    const std::map<std::string,
+                   std::function<int(const std::vector<std::string> &)>>
+        benchmarks{
+            {"offscreen", BenchmarkOffscreen},
+            {"bbox", BenchmarkBoundingBox},
+            {"commands", BenchmarkCommands},
+            {"generate", BenchmarkGenerate},
+            {"layers", BenchmarkLayers},
+            {"load", BenchmarkLoad},
+            {"load-one", BenchmarkLoadOne},
+            {"sensors", BenchmarkSensors},
+            {"ui", BenchmarkUi},
+        };
+
+    ProgramPath = argv[0];
+
+    std::string name = argc > 1 ? argv[1] : "offscreen";
+    auto it = benchmarks.find(name);
+    if (it == benchmarks.end()) {
+        spdlog::error("unknown benchmark: {}", name);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> args(argv + std::min(argc, 2), argv + argc);
+    return it->second(args);
+}
@@ -1,10 +1,6 @@
 #include "CoinApp.h"
 
-#include <Inventor/actions/SoGLRenderAction.h>
-#include <Inventor/elements/SoCacheElement.h>
-#include <Inventor/nodes/SoCallback.h>
 #include <Inventor/nodes/SoCone.h>
-#include <Inventor/nodes/SoDepthBuffer.h>
 #include <Inventor/nodes/SoMaterial.h>
 #include <Inventor/nodes/SoSeparator.h>
 #include <Inventor/nodes/SoTransform.h>
@@ -13,7 +9,13 @@
 
 #include <spdlog/spdlog.h>
 
-std::pair<SoSeparator *, SoTransform *> CreateDemoScene()
+struct DemoScene {
+    SoSeparator *scene;
+    SoTransform *trans;
+    SoCone *cone;
+};
+
+DemoScene CreateDemoScene()
 {
     SoSeparator *scene = new SoSeparator;
     SoMaterial *mat = new SoMaterial;
@@ -26,46 +28,39 @@ std::pair<SoSeparator *, SoTransform *> CreateDemoScene()
     auto cone = new SoCone;
     scene->addChild(cone);
 
-    auto sodepthBuffer = new SoDepthBuffer;
-    sodepthBuffer->test = false;
-    scene->addChild(sodepthBuffer);
-
-    auto socb = new SoCallback;
-    socb->setCallback(
-        [](void *data, SoAction *action) {
-            auto cone = static_cast<SoCone *>(data);
-            if (action->isOfType(SoGLRenderAction::getClassTypeId())) {
-                // must invalidate the cache to trigger the callback every frame
-                SoCacheElement::invalidate(action->getState());
-                ImGui::Begin("Cone");
-                static float bottomRadius = cone->bottomRadius.getValue();
-                if (ImGui::SliderFloat("Bottom Radius", &bottomRadius, 1.f,
-                                       10.0f)) {
-                    cone->bottomRadius.setValue(bottomRadius);
-                }
-                static float height = cone->height.getValue();
-                if (ImGui::SliderFloat("Height", &height, 1.f, 10.0f)) {
-                    cone->height.setValue(height);
-                }
-                ImGui::End();
-            }
-        },
-        cone);
-    scene->addChild(socb);
-
-    return {scene, trans};
+    return {scene, trans, cone};
 }
 
-int main()
+int main(int argc, char **argv)
 {
     spdlog::set_level(spdlog::level::debug);
 
     zen::CoinApp app;
 
-    auto [ scene, trans] = CreateDemoScene();
+    auto [scene, trans, cone] = CreateDemoScene();
 
     app.SetSceneGraph(scene);
     app.SetGizmoTransform(trans);
+    // drawn outside the render traversal, the scene keeps its render caches
+    app.AddUiHook(cone, [cone = cone] {
+        ImGui::Begin("Cone");
+        float bottomRadius = cone->bottomRadius.getValue();
+        if (ImGui::SliderFloat("Bottom Radius", &bottomRadius, 1.f, 10.0f)) {
+            cone->bottomRadius.setValue(bottomRadius);
+        }
+        float height = cone->height.getValue();
+        if (ImGui::SliderFloat("Height", &height, 1.f, 10.0f)) {
+            cone->height.setValue(height);
+        }
+        ImGui::End();
+    });
+    app.SetRenderMode(zen::RenderMode::OnDemand);
+    // large files stay responsive while orbiting, even on llvmpipe
+    app.SetAdaptiveQuality(zen::QualityMode::Resolution);
+    // the demo scene stays interactive while the file is parsed
+    if (argc > 1) {
+        app.LoadSceneAsync(argv[1]);
+    }
 
     app.Run();
 
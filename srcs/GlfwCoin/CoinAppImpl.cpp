@@ -7,6 +7,7 @@
  * @date 22:13:47, April 11, 2025
  */
 #include "CoinAppImpl.h"
+#include "SceneCache.h"
 
 #include "EventCallback.h"
 
@@ -17,10 +18,11 @@
 
 #include <Inventor/SoDB.h>
 #include <Inventor/SoInteraction.h>
+#include <Inventor/actions/SoGLRenderAction.h>
 #include <Inventor/actions/SoGetBoundingBoxAction.h>
-#include <Inventor/actions/SoHandleEventAction.h>
 #include <Inventor/actions/SoSearchAction.h>
 #include <Inventor/nodekits/SoNodeKit.h>
+#include <Inventor/nodes/SoDirectionalLight.h>
 #include <Inventor/nodes/SoOrthographicCamera.h>
 #include <Inventor/nodes/SoPerspectiveCamera.h>
 #include <Inventor/scxml/ScXML.h>
@@ -34,10 +36,95 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+
+#ifndef GL_DEPTH24_STENCIL8
+#define GL_DEPTH24_STENCIL8 0x88F0
+#endif
+#ifndef GL_DEPTH_COMPONENT24
+#define GL_DEPTH_COMPONENT24 0x81A6
+#endif
+#ifndef GL_SAMPLES
+#define GL_SAMPLES 0x80A9
+#endif
 
 namespace zen
 {
+static ImGuiKey ToImGuiKey(int key)
+{
+    if (key >= GLFW_KEY_A && key <= GLFW_KEY_Z) {
+        return ImGuiKey(ImGuiKey_A + (key - GLFW_KEY_A));
+    }
+    if (key >= GLFW_KEY_0 && key <= GLFW_KEY_9) {
+        return ImGuiKey(ImGuiKey_0 + (key - GLFW_KEY_0));
+    }
+    if (key >= GLFW_KEY_F1 && key <= GLFW_KEY_F12) {
+        return ImGuiKey(ImGuiKey_F1 + (key - GLFW_KEY_F1));
+    }
+
+    switch (key) {
+    case GLFW_KEY_TAB:
+        return ImGuiKey_Tab;
+    case GLFW_KEY_LEFT:
+        return ImGuiKey_LeftArrow;
+    case GLFW_KEY_RIGHT:
+        return ImGuiKey_RightArrow;
+    case GLFW_KEY_UP:
+        return ImGuiKey_UpArrow;
+    case GLFW_KEY_DOWN:
+        return ImGuiKey_DownArrow;
+    case GLFW_KEY_PAGE_UP:
+        return ImGuiKey_PageUp;
+    case GLFW_KEY_PAGE_DOWN:
+        return ImGuiKey_PageDown;
+    case GLFW_KEY_HOME:
+        return ImGuiKey_Home;
+    case GLFW_KEY_END:
+        return ImGuiKey_End;
+    case GLFW_KEY_INSERT:
+        return ImGuiKey_Insert;
+    case GLFW_KEY_DELETE:
+        return ImGuiKey_Delete;
+    case GLFW_KEY_BACKSPACE:
+        return ImGuiKey_Backspace;
+    case GLFW_KEY_SPACE:
+        return ImGuiKey_Space;
+    case GLFW_KEY_ENTER:
+        return ImGuiKey_Enter;
+    case GLFW_KEY_ESCAPE:
+        return ImGuiKey_Escape;
+    case GLFW_KEY_LEFT_CONTROL:
+        return ImGuiKey_LeftCtrl;
+    case GLFW_KEY_LEFT_SHIFT:
+        return ImGuiKey_LeftShift;
+    case GLFW_KEY_LEFT_ALT:
+        return ImGuiKey_LeftAlt;
+    case GLFW_KEY_LEFT_SUPER:
+        return ImGuiKey_LeftSuper;
+    case GLFW_KEY_RIGHT_CONTROL:
+        return ImGuiKey_RightCtrl;
+    case GLFW_KEY_RIGHT_SHIFT:
+        return ImGuiKey_RightShift;
+    case GLFW_KEY_RIGHT_ALT:
+        return ImGuiKey_RightAlt;
+    case GLFW_KEY_RIGHT_SUPER:
+        return ImGuiKey_RightSuper;
+    default:
+        return ImGuiKey_None;
+    }
+}
+
+static void AddImGuiMods(ImGuiIO &io, int mods)
+{
+    io.AddKeyEvent(ImGuiMod_Ctrl, mods & GLFW_MOD_CONTROL);
+    io.AddKeyEvent(ImGuiMod_Shift, mods & GLFW_MOD_SHIFT);
+    io.AddKeyEvent(ImGuiMod_Alt, mods & GLFW_MOD_ALT);
+    io.AddKeyEvent(ImGuiMod_Super, mods & GLFW_MOD_SUPER);
+}
+
 CoinAppImpl::CoinAppImpl()
 {
     const char DEFAULT_NAVIGATIONFILE[] = "coin:scxml/navigation/examiner.xml";
@@ -47,11 +134,20 @@ CoinAppImpl::CoinAppImpl()
     SoInteraction::init();
 
     render_manager = new SoRenderManager;
-    render_manager->setAutoClipping(SoRenderManager::VARIABLE_NEAR_PLANE);
+    // the clipping planes come from the cached bounding box, see
+    // UpdateClippingPlanes
+    render_manager->setAutoClipping(SoRenderManager::NO_AUTO_CLIPPING);
     render_manager->setRenderCallback(RenderCallback, this);
     render_manager->setBackgroundColor(SbColor4f(0.3f, 0.3f, 0.3f, 0.0f));
     render_manager->activate();
 
+    dynamic_layers = new SoSeparator;
+    dynamic_layers->ref();
+    // the root sensor of the render manager does not see the layers
+    dynamic_sensor.setFunction(DynamicLayerCallback);
+    dynamic_sensor.setData(this);
+    dynamic_sensor.attach(dynamic_layers);
+
     event_manager = new SoEventManager;
     event_manager->setNavigationState(SoEventManager::MIXED_NAVIGATION);
 
@@ -66,6 +162,10 @@ CoinAppImpl::CoinAppImpl()
         spdlog::warn("not a SoScXMLStateMachine: {}", DEFAULT_NAVIGATIONFILE);
         delete sm;
     }
+
+    // wake up a loop sleeping in glfwWaitEvents to swap the scene in
+    scene_loader.on_finished = [] { glfwPostEmptyEvent(); };
+    scene_loader.cache_directory = DefaultSceneCacheDirectory();
 }
 
 CoinAppImpl::~CoinAppImpl()
@@ -85,6 +185,22 @@ CoinAppImpl::~CoinAppImpl()
         root = nullptr;
     }
 
+    if (event_root) {
+        event_root->unref();
+        event_root = nullptr;
+    }
+
+    if (dynamic_root) {
+        dynamic_root->unref();
+        dynamic_root = nullptr;
+    }
+
+    dynamic_sensor.detach();
+    if (dynamic_layers) {
+        dynamic_layers->unref();
+        dynamic_layers = nullptr;
+    }
+
     camera = nullptr;
     gizmo_transform = nullptr;
 }
@@ -100,6 +216,7 @@ void CoinAppImpl::UpdateImGuizmo()
         m[3] = glm::vec4(x, y, z, 1.0f);
         model_matrix = m;
     }
+    synced_model_matrix = model_matrix;
 
     if (camera && camera->isOfType(SoPerspectiveCamera::getClassTypeId())) {
         auto cam = static_cast<SoPerspectiveCamera *>(camera);
@@ -118,49 +235,789 @@ void CoinAppImpl::UpdateImGuizmo()
         // view matrix is the inverse of the camera matrix
         view_matrix = glm::inverse(cameraMatrix);
     }
+    synced_view_matrix = view_matrix;
 }
 
 void CoinAppImpl::SyncImGuizmo()
 {
     if (camera) {
-        ///@note glm matrix is column major, the 3rd column is the camera
-        /// position
-        // camera matrix is the inverse of the view matrix
-        auto cameraMatrix = glm::inverse(view_matrix);
-        camera->position.setValue(cameraMatrix[3][0], cameraMatrix[3][1],
-                                  cameraMatrix[3][2]);
-        glm::quat q(cameraMatrix);
-        camera->orientation.setValue(q.x, q.y, q.z, q.w);
+        if (view_matrix == synced_view_matrix) {
+            sync_stats.suppressed += 2;
+        } else {
+            ///@note glm matrix is column major, the 3rd column is the camera
+            /// position
+            // camera matrix is the inverse of the view matrix
+            auto cameraMatrix = glm::inverse(view_matrix);
+            glm::quat q(cameraMatrix);
+            SyncField(camera->position,
+                      SbVec3f(cameraMatrix[3][0], cameraMatrix[3][1],
+                              cameraMatrix[3][2]),
+                      sync_stats);
+            SyncField(camera->orientation, SbRotation(q.x, q.y, q.z, q.w),
+                      sync_stats);
+        }
     }
 
     if (gizmo_transform) {
-        // sync transform to modelMatrix
-        gizmo_transform->translation.setValue(model_matrix[3][0], model_matrix[3][1],
-                                        model_matrix[3][2]);
-        glm::quat q(model_matrix);
-        gizmo_transform->rotation.setValue(q.x, q.y, q.z, q.w);
+        if (model_matrix == synced_model_matrix) {
+            sync_stats.suppressed += 2;
+        } else {
+            // sync transform to modelMatrix
+            glm::quat q(model_matrix);
+            SyncField(gizmo_transform->translation,
+                      SbVec3f(model_matrix[3][0], model_matrix[3][1],
+                              model_matrix[3][2]),
+                      sync_stats);
+            SyncField(gizmo_transform->rotation,
+                      SbRotation(q.x, q.y, q.z, q.w), sync_stats);
+        }
     }
 }
 
+void CoinAppImpl::SetSceneGraph(SoNode *scene)
+{
+    if (root) {
+        root->unref();
+    }
+
+    root = new SoSeparator;
+    root->ref();
+
+    camera = nullptr;
+    gizmo_transform = nullptr;
+    viewport_size = {0, 0};
+
+    SoDirectionalLight *light = new SoDirectionalLight;
+    light->direction = SbVec3f(0, 0, -1);
+
+    root->addChild(light);
+
+    root->addChild(scene);
+
+    if (auto scene_camera = SearchForCamera(root)) {
+        camera = scene_camera;
+    } else {
+        SoPerspectiveCamera *pcam = new SoPerspectiveCamera;
+        pcam->heightAngle = glm::radians(45.f);
+        pcam->nearDistance = 0.01f;
+        pcam->farDistance = 1000.0f;
+        pcam->position = SbVec3f(0, 0, 10);
+        pcam->focalDistance = 10.0f;
+        pcam->pointAt(SbVec3f(0, 0, 0), SbVec3f(0, 1, 0));
+        camera = pcam;
+        root->insertChild(pcam, 0);
+    }
+
+    // owned by the old root, UpdateQuality inserts a new one on demand
+    complexity = nullptr;
+    quality.SetCamera(camera);
+
+    // imgui draws after the scene through the ui hooks and ProcessInput
+    // keeps the events it captured from the scene, no node in the graph
+    // has to be traversed every frame
+
+    // the camera is shared as is, a transform above a camera found in the
+    // scene does not apply to the layers
+    if (dynamic_root) {
+        dynamic_root->unref();
+    }
+    dynamic_root = new SoSeparator;
+    dynamic_root->ref();
+    dynamic_root->addChild(light);
+    dynamic_root->addChild(camera);
+    dynamic_root->addChild(dynamic_layers);
+
+    if (event_root) {
+        event_root->unref();
+    }
+    event_root = new SoGroup;
+    event_root->ref();
+    event_root->addChild(root);
+    event_root->addChild(dynamic_root);
+
+    render_manager->setSceneGraph(root);
+    render_manager->setCamera(camera);
+
+    event_manager->setSceneGraph(event_root);
+    event_manager->setCamera(camera);
+
+    static_layer.SetSceneGraph(root);
+    bbox_cache.SetSceneGraph(root, camera);
+    layers_bbox_cache.SetSceneGraph(dynamic_layers);
+    ViewAll();
+}
+
 std::pair<int, int> CoinAppImpl::GetWindowSize()
 {
+    // a replay drives the framebuffer size from the log
+    if (replayer.IsActive()) {
+        return viewport_size;
+    }
+
     int width, height;
     glfwGetFramebufferSize(window, &width, &height);
     return {width, height};
 }
 
+bool CoinAppImpl::AcceptInput(const InputRecord &record)
+{
+    // live input would disturb a replay
+    if (replayer.IsActive() && !replayer.dispatching) {
+        return false;
+    }
+
+    if (recorder.IsOpen()) {
+        recorder.Write(record, glfwGetTime());
+    }
+    return true;
+}
+
+void CoinAppImpl::PollSceneLoader()
+{
+    switch (scene_loader.GetState()) {
+    case SceneLoader::State::Loading:
+        RequestRedraw(1);
+        break;
+    case SceneLoader::State::Finished: {
+        SoSeparator *scene = scene_loader.TakeResult();
+        SPDLOG_INFO("loaded scene {}", scene_loader.GetPath());
+        SetSceneGraph(scene);
+        scene->unref();
+        RequestRedraw();
+        break;
+    }
+    case SceneLoader::State::Failed:
+        SPDLOG_ERROR("failed to load scene {}", scene_loader.GetPath());
+        scene_loader.TakeResult();
+        RequestRedraw();
+        break;
+    default:
+        break;
+    }
+}
+
+void CoinAppImpl::ReplayInput()
+{
+    if (!replayer.IsActive() || replay_frame_pending) {
+        return;
+    }
+
+    if (replayer.AtEnd()) {
+        FinishReplay();
+        return;
+    }
+
+    // WaitEvents sleeps until the recorded time, live events wake it early
+    if (replay_options.realtime &&
+        replay_start + replayer.NextFrameTime() > glfwGetTime()) {
+        return;
+    }
+
+    SetImGuiLiveInput(false);
+    replayer.dispatching = true;
+    while (!replayer.AtEnd()) {
+        auto &record = replayer.records[replayer.cursor++];
+        if (record.type == InputRecordType::FrameEnd) {
+            break;
+        }
+        ReplayToImGui(record);
+
+        switch (record.type) {
+        case InputRecordType::FramebufferSize:
+            framebufferSizeCallback(window, record.ints[0], record.ints[1]);
+            break;
+        case InputRecordType::MouseButton:
+            mouseClickCallback(window, record.ints[0], record.ints[1],
+                               record.ints[2]);
+            break;
+        case InputRecordType::MouseMove:
+            mouseMoveCallback(window, record.doubles[0], record.doubles[1]);
+            break;
+        case InputRecordType::MouseWheel:
+            mouseWheelCallback(window, record.doubles[0], record.doubles[1]);
+            break;
+        case InputRecordType::Key:
+            keyCallback(window, record.ints[0], record.ints[1], record.ints[2],
+                        record.ints[3]);
+            break;
+        default:
+            break;
+        }
+    }
+    replayer.dispatching = false;
+
+    replay_frame_pending = true;
+    RequestRedraw(1);
+}
+
+void CoinAppImpl::ReplayToImGui(const InputRecord &record)
+{
+    if (!ImGui::GetCurrentContext()) {
+        return;
+    }
+
+    ImGuiIO &io = ImGui::GetIO();
+    switch (record.type) {
+    case InputRecordType::MouseButton:
+        if (record.ints[0] >= 0 && record.ints[0] < ImGuiMouseButton_COUNT) {
+            AddImGuiMods(io, record.ints[2]);
+            io.AddMouseButtonEvent(record.ints[0],
+                                   record.ints[1] == GLFW_PRESS);
+        }
+        break;
+    case InputRecordType::MouseMove:
+        replay_cursor = {record.doubles[0], record.doubles[1]};
+        io.AddMousePosEvent(float(record.doubles[0]),
+                            float(record.doubles[1]));
+        break;
+    case InputRecordType::MouseWheel:
+        io.AddMouseWheelEvent(float(record.doubles[0]),
+                              float(record.doubles[1]));
+        break;
+    case InputRecordType::Key: {
+        AddImGuiMods(io, record.ints[3]);
+        ImGuiKey key = ToImGuiKey(record.ints[0]);
+        if (key != ImGuiKey_None && record.ints[2] != GLFW_REPEAT) {
+            io.AddKeyEvent(key, record.ints[2] == GLFW_PRESS);
+        }
+    } break;
+    default:
+        break;
+    }
+}
+
+void CoinAppImpl::SetImGuiLiveInput(bool enabled)
+{
+    if (enabled == imgui_live_input || !ImGui::GetCurrentContext()) {
+        return;
+    }
+    imgui_live_input = enabled;
+
+    // without the backend callbacks glfw calls ours directly, and those
+    // ignore live input while replaying
+    if (enabled) {
+        ImGui_ImplGlfw_InstallCallbacks(window);
+    } else {
+        ImGui_ImplGlfw_RestoreCallbacks(window);
+        replay_cursor = {-1.0, -1.0};
+    }
+}
+
+void CoinAppImpl::FinishReplay()
+{
+    double elapsed = glfwGetTime() - replay_start;
+    auto stats = FrameProfiler::ComputeStatistics(replay_timings);
+    auto &total = stats[FramePhaseCount];
+    spdlog::info("replayed {} frames in {:.3f}s, frame ms: min {:.3f} avg "
+                 "{:.3f} p95 {:.3f} p99 {:.3f}",
+                 replay_timings.size(), elapsed, total.min, total.avg,
+                 total.p95, total.p99);
+    for (size_t phase = 0; phase < FramePhaseCount; ++phase) {
+        auto &s = stats[phase];
+        spdlog::info("  {:<12} avg {:.3f} p95 {:.3f} p99 {:.3f}",
+                     ToString(static_cast<FramePhase>(phase)), s.avg, s.p95,
+                     s.p99);
+    }
+
+    if (!replay_options.timings_file.empty()) {
+        std::ofstream out(replay_options.timings_file);
+        out << FrameProfiler::ToJson(replay_timings);
+    }
+
+    replayer.Close();
+    replay_timings.clear();
+    SetImGuiLiveInput(true);
+    // hand the viewport back to the window
+    viewport_size = {0, 0};
+
+    if (replay_options.close_when_done) {
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
+    }
+}
+
+void CoinAppImpl::FinishFrame()
+{
+    last_sync_stats = sync_stats;
+    sync_stats.Reset();
+
+    if (recorder.IsOpen()) {
+        recorder.Write(InputRecord{InputRecordType::FrameEnd}, glfwGetTime());
+    }
+
+    auto frames = profiler.GetFrames(1);
+    if (!frames.empty()) {
+        quality.EndFrame(frames.back().total);
+    }
+
+    if (replay_frame_pending) {
+        if (!frames.empty()) {
+            replay_timings.push_back(frames.back());
+        }
+        replay_frame_pending = false;
+    }
+}
+
+void CoinAppImpl::PostCommand(Command command)
+{
+    // only the first command wakes a loop sleeping in glfwWaitEvents, which
+    // is safe to call from any thread
+    if (commands.Push(std::move(command))) {
+        glfwPostEmptyEvent();
+    }
+}
+
+void CoinAppImpl::QueueInput(const InputEvent &input)
+{
+    if (input.type == InputEvent::Type::Move && !input_queue.empty() &&
+        input_queue.back().type == InputEvent::Type::Move) {
+        input_queue.back() = input;
+        ++coalesced_moves;
+        return;
+    }
+    input_queue.push_back(input);
+}
+
+void CoinAppImpl::ProcessInput()
+{
+    // events over an imgui window never reach the scene graph, imgui updates
+    // the capture flag in NewFrame, so this is the state of the last frame.
+    // While replaying imgui only sees the recorded input, the flag follows
+    // the replayed cursor like it followed the live one when recording.
+    bool imgui_capture =
+        ImGui::GetCurrentContext() && ImGui::GetIO().WantCaptureMouse;
+
+    for (auto &input : input_queue) {
+        if (imgui_capture) {
+            // presses and moves over imgui are no interaction, but a button
+            // pressed over the scene and released over imgui must not stay
+            // down
+            if (input.type == InputEvent::Type::Button &&
+                input.action == GLFW_RELEASE) {
+                quality.OnInput(input, glfwGetTime());
+            }
+            ++imgui_captured_events;
+            continue;
+        }
+        quality.OnInput(input, glfwGetTime());
+        dispatchInputEvent(this, input);
+    }
+    input_queue.clear();
+}
+
+void CoinAppImpl::RequestRedraw(int frames)
+{
+    redraw_frames = std::max(redraw_frames, frames);
+}
+
+double CoinAppImpl::GetSensorTimeout()
+{
+    if (commands.GetDepth() > 0) {
+        return 0.0;
+    }
+
+    auto sensor_manager = SoDB::getSensorManager();
+    if (sensor_manager->isDelaySensorPending()) {
+        return 0.0;
+    }
+
+    SbTime next;
+    if (sensor_manager->isTimerSensorPending(next)) {
+        return std::max(0.0, (next - SbTime::getTimeOfDay()).getValue());
+    }
+
+    // nothing scheduled, sleep until the next input event
+    return -1.0;
+}
+
+bool CoinAppImpl::AreSensorsDue()
+{
+    auto sensor_manager = SoDB::getSensorManager();
+    SbTime next;
+    return sensor_manager->isDelaySensorPending() ||
+           (sensor_manager->isTimerSensorPending(next) &&
+            next <= SbTime::getTimeOfDay());
+}
+
+void CoinAppImpl::WaitEvents()
+{
+    double timeout = -1.0;
+    if (render_mode == RenderMode::Continuous || redraw_frames > 0) {
+        timeout = 0.0;
+        if (max_frame_rate > 0.0) {
+            timeout = std::max(
+                0.0, last_frame_time + 1.0 / max_frame_rate - glfwGetTime());
+        }
+    }
+
+    // the sensors run with the next frame, a capped frame rate holds them
+    // back as well
+    double sensor_timeout = GetSensorTimeout();
+    if (sensor_timeout >= 0.0 && max_frame_rate > 0.0) {
+        sensor_timeout =
+            std::max(sensor_timeout, last_frame_time + 1.0 / max_frame_rate -
+                                         glfwGetTime());
+    }
+    if (sensor_timeout >= 0.0 && (timeout < 0.0 || sensor_timeout < timeout)) {
+        timeout = sensor_timeout;
+    }
+
+    // the refinement frame once the interaction went idle
+    double quality_timeout = quality.GetTimeout(glfwGetTime());
+    if (quality_timeout >= 0.0 &&
+        (timeout < 0.0 || quality_timeout < timeout)) {
+        timeout = quality_timeout;
+    }
+
+    // keep the progress bar moving while a scene is parsed
+    if (scene_loader.IsLoading() && (timeout < 0.0 || timeout > 0.1)) {
+        timeout = 0.1;
+    }
+
+    // the next replayed frame, right away or at its recorded time
+    if (replayer.IsActive() && !replay_frame_pending) {
+        double replay_timeout = 0.0;
+        if (replay_options.realtime && !replayer.AtEnd()) {
+            replay_timeout =
+                std::max(0.0, replay_start + replayer.NextFrameTime() -
+                                  glfwGetTime());
+        }
+        if (timeout < 0.0 || replay_timeout < timeout) {
+            timeout = replay_timeout;
+        }
+    }
+
+    if (timeout < 0.0) {
+        glfwWaitEvents();
+    } else if (timeout == 0.0) {
+        glfwPollEvents();
+    } else {
+        glfwWaitEventsTimeout(timeout);
+    }
+}
+
+bool CoinAppImpl::BeginFrame()
+{
+    double now = glfwGetTime();
+    if (max_frame_rate > 0.0 && now - last_frame_time < 1.0 / max_frame_rate) {
+        return false;
+    }
+
+    if (render_mode == RenderMode::OnDemand) {
+        // the sensors only run in a frame, they may be what asks for it
+        if (redraw_frames <= 0 && !AreSensorsDue()) {
+            return false;
+        }
+        redraw_frames = std::max(0, redraw_frames - 1);
+    }
+
+    last_frame_time = now;
+    return true;
+}
+
 void CoinAppImpl::UpdateViewport()
 {
+    auto size = GetWindowSize();
+    // resetting the viewport touches camera->aspectRatio, which would
+    // invalidate the render caches and schedule a redraw every frame
+    if (size == viewport_size) {
+        return;
+    }
+    framebufferSizeCallback(window, size.first, size.second);
+}
+
+void CoinAppImpl::ViewAll()
+{
+    const auto &viewport = render_manager->getViewportRegion();
+    SbBox3f box = bbox_cache.GetBox(viewport);
+    if (box.isEmpty()) {
+        return;
+    }
+    camera->viewBoundingBox(box, viewport.getViewportAspectRatio(), 1.0f);
+}
+
+void CoinAppImpl::UpdateClippingPlanes()
+{
+    // same as coin's VARIABLE_NEAR_PLANE, but on the cached boxes
+    if (!camera) {
+        return;
+    }
+    const SbViewportRegion &viewport = render_manager->getViewportRegion();
+    SbXfBox3f xbox = bbox_cache.GetXfBox(viewport);
+    const SbXfBox3f &layers_box = layers_bbox_cache.GetXfBox(viewport);
+    if (!layers_box.isEmpty()) {
+        xbox.extendBy(layers_box);
+    }
+    if (xbox.isEmpty()) {
+        return;
+    }
+
+    SbMatrix mat;
+    mat.setTranslate(-camera->position.getValue());
+    xbox.transform(mat);
+    mat = camera->orientation.getValue().inverse();
+    xbox.transform(mat);
+    SbBox3f box = xbox.project();
+
+    float near_value = -box.getMax()[2];
+    float far_value = -box.getMin()[2];
+    if (far_value <= 0.0f) {
+        return;
+    }
+
+    bool perspective =
+        camera->isOfType(SoPerspectiveCamera::getClassTypeId());
+    int use_bits = 0;
+    if (perspective) {
+        if (depth_bits == 0) {
+            glGetIntegerv(GL_DEPTH_BITS, &depth_bits);
+            if (depth_bits <= 0) {
+                depth_bits = 24;
+            }
+        }
+        use_bits = int(float(depth_bits) *
+                       (1.0f - render_manager->getNearPlaneValue()));
+    }
+    // the closest near plane the depth buffer still resolves up to far
+    auto limit_near = [&](float near_plane, float far_plane) {
+        if (!perspective) {
+            return near_plane;
+        }
+        float near_limit = far_plane / std::pow(2.0f, float(use_bits));
+        if (near_limit >= far_plane) {
+            near_limit = far_plane / 5000.0f;
+        }
+        return std::max(near_plane, near_limit);
+    };
+
+    // the depth of the cached image belongs to the range it was rendered
+    // with. Layers moving inside that range, e.g. a dragged dragger, are
+    // drawn over the image as it is, only leaving it renders root again.
+    bool layered = static_layer_caching && dynamic_layers &&
+                   dynamic_layers->getNumChildren() > 0;
+    if (layered && !static_layer.IsDirty()) {
+        float camera_far = camera->farDistance.getValue();
+        if (limit_near(near_value, camera_far) >=
+                camera->nearDistance.getValue() &&
+            far_value <= camera_far) {
+            return;
+        }
+    }
+
+    // root is rendered again anyway, the range gets room for the layers
+    if (layered) {
+        constexpr float Margin = 0.25f;
+        float margin = Margin * (box.getMax() - box.getMin()).length();
+        near_value -= margin;
+        far_value += margin;
+    }
+    near_value = limit_near(near_value, far_value);
+
+    // written without notification like coin does, a redraw would follow
+    // every frame otherwise
+    constexpr float Slack = 0.001f;
+    near_value *= 1.0f - Slack;
+    far_value *= 1.0f + Slack;
+    if (near_value == camera->nearDistance.getValue() &&
+        far_value == camera->farDistance.getValue()) {
+        return;
+    }
+    camera->enableNotify(FALSE);
+    camera->nearDistance = near_value;
+    camera->farDistance = far_value;
+    camera->enableNotify(TRUE);
+    // the depth of the cached image belongs to the old range, the layers
+    // would be tested against it with the new one
+    static_layer.Invalidate();
+}
+
+void CoinAppImpl::UpdateQuality()
+{
+    if (quality.Update(glfwGetTime())) {
+        RequestRedraw(1);
+    }
+
+    // only in the graph while the mode needs it, other modes leave the
+    // scene and its caches as they were
+    if (quality.GetMode() != QualityMode::Complexity) {
+        if (complexity) {
+            root->removeChild(complexity);
+            complexity = nullptr;
+        }
+        return;
+    }
+    if (!root) {
+        return;
+    }
+    if (!complexity) {
+        complexity = new SoComplexity;
+        complexity->type.setIgnored(TRUE);
+        complexity->textureQuality.setIgnored(TRUE);
+        root->insertChild(complexity, 0);
+    }
+
+    // a notifying write, the render caches and the static layer depend on
+    // the complexity. The scale moves in steps, most frames write nothing.
+    constexpr float DefaultComplexity = 0.5f;
+    float value = DefaultComplexity * quality.GetScale();
+    if (complexity->value.getValue() != value) {
+        complexity->value = value;
+    }
+}
+
+void CoinAppImpl::Render(OffscreenTarget *target)
+{
+    // RenderOffscreen set up the viewport of its target
+    if (target) {
+        UpdateClippingPlanes();
+        RenderLayers(target);
+        return;
+    }
+
     auto [width, height] = GetWindowSize();
-    framebufferSizeCallback(window, width, height);
+    int scaled_width = width;
+    int scaled_height = height;
+    if (quality.GetMode() == QualityMode::Resolution && width > 0 &&
+        height > 0) {
+        float scale = quality.GetScale();
+        scaled_width = std::max(1, int(float(width) * scale));
+        scaled_height = std::max(1, int(float(height) * scale));
+    }
+    // only set on a scale change, the event manager keeps the window size
+    SbViewportRegion region(scaled_width, scaled_height);
+    if (!(render_manager->getViewportRegion() == region)) {
+        render_manager->setViewportRegion(region);
+    }
+
+    // fitted around root and the layers, kept while the layers stay inside
+    // the depth range of the cached image
+    UpdateClippingPlanes();
+    if (scaled_width == width && scaled_height == height) {
+        RenderLayers(nullptr);
+        return;
+    }
+
+    auto context = render_manager->getGLRenderAction()->getCacheContext();
+    if (!scaled_target.Resize(cc_glglue_instance(context), scaled_width,
+                              scaled_height)) {
+        quality.SetMode(QualityMode::Full, quality.GetBudget());
+        render_manager->setViewportRegion(SbViewportRegion(width, height));
+        RenderLayers(nullptr);
+        return;
+    }
+    scaled_target.Bind();
+    RenderLayers(&scaled_target);
+    if (!scaled_target.BlitTo(0, width, height, GL_COLOR_BUFFER_BIT,
+                              GL_LINEAR)) {
+        scaled_target.Unbind();
+        spdlog::warn("cannot upscale the frame, adaptive quality is off");
+        quality.SetMode(QualityMode::Full, quality.GetBudget());
+    }
+}
+
+void CoinAppImpl::RenderLayers(OffscreenTarget *target)
+{
+    if (!dynamic_layers->getNumChildren()) {
+        render_manager->render();
+        return;
+    }
+
+    GLenum depth_format = target ? target->depth_format : 0;
+    if (static_layer_caching && !target) {
+        depth_format = GetWindowDepthFormat();
+        if (!depth_format) {
+            spdlog::warn("the window depth buffer cannot take a copy of the "
+                         "cached scene, static layer caching is off");
+            static_layer_caching = false;
+            static_layer.Release();
+        }
+    }
+
+    bool cached = false;
+    if (static_layer_caching) {
+        auto action = render_manager->getGLRenderAction();
+        auto glue = cc_glglue_instance(action->getCacheContext());
+        auto size = render_manager->getViewportRegion().getWindowSize();
+        cached = static_layer.Draw(glue, size[0], size[1],
+                                   target ? target->framebuffer : 0,
+                                   depth_format,
+                                   [this] { render_manager->render(); });
+    }
+    if (!cached) {
+        render_manager->render();
+    }
+    render_manager->getGLRenderAction()->apply(dynamic_root);
+}
+
+GLenum CoinAppImpl::GetWindowDepthFormat()
+{
+    if (window_depth_format != GLenum(-1)) {
+        return window_depth_format;
+    }
+
+    // called with the window framebuffer bound. A depth blit needs the same
+    // format on both sides, and a multisampled window cannot take one.
+    GLint depth = 0;
+    GLint stencil = 0;
+    GLint samples = 0;
+    glGetIntegerv(GL_DEPTH_BITS, &depth);
+    glGetIntegerv(GL_STENCIL_BITS, &stencil);
+    glGetIntegerv(GL_SAMPLES, &samples);
+    window_depth_format = 0;
+    if (samples == 0 && depth == 24 && stencil == 8) {
+        window_depth_format = GL_DEPTH24_STENCIL8;
+    } else if (samples == 0 && depth == 24 && stencil == 0) {
+        window_depth_format = GL_DEPTH_COMPONENT24;
+    }
+    return window_depth_format;
+}
+
+bool CoinAppImpl::RenderOffscreen(int width, int height, unsigned char *rgba,
+                                  float *depth)
+{
+    glfwMakeContextCurrent(window);
+
+    auto context = render_manager->getGLRenderAction()->getCacheContext();
+    if (!offscreen.Resize(cc_glglue_instance(context), width, height)) {
+        return false;
+    }
+
+    // the image has to show every pending change
+    commands.Drain();
+    IdleCallback(false);
+
+    // the window viewport gets restored by the next UpdateViewport
+    viewport_size = {0, 0};
+    render_manager->setViewportRegion(SbViewportRegion(width, height));
+    if (camera) {
+        SyncField(camera->aspectRatio, float(width) / float(height),
+                  sync_stats);
+    }
+
+    offscreen.Bind();
+    Render(&offscreen);
+    if (rgba) {
+        offscreen.ReadColor(rgba);
+    }
+    if (depth) {
+        offscreen.ReadDepth(depth);
+    }
+    offscreen.Unbind();
+
+    return true;
 }
 
-void CoinAppImpl::Render() { render_manager->render(); }
+void CoinAppImpl::IdleCallback(bool budgeted)
+{
+    sensor_pump.Process(budgeted);
+}
 
-void CoinAppImpl::IdleCallback()
+void CoinAppImpl::ProcessFrameSensors()
 {
-    SoDB::getSensorManager()->processTimerQueue();
-    SoDB::getSensorManager()->processDelayQueue(true);
+    // right before the frame is drawn, the redraws the sensors ask for would
+    // only add another frame
+    in_frame_sensors = true;
+    IdleCallback();
+    in_frame_sensors = false;
 }
 
 void CoinAppImpl::ImGuiDraw()
@@ -185,12 +1042,83 @@ void CoinAppImpl::ImGuiDraw()
 
     // ImGui::ShowDemoWindow();
 
+    if (show_frame_timings) {
+        profiler.DrawHud(&show_frame_timings);
+        DrawStatistics();
+    }
+
+    if (scene_loader.IsLoading()) {
+        DrawLoadingProgress();
+    }
+
     if (imGuiCallback) {
         imGuiCallback();
     }
+    ui_hooks.Draw();
+
+    // only writes back what the gizmos actually moved, writing the fields
+    // unconditionally fires the root sensor and invalidates the caches
     SyncImGuizmo();
 }
 
+void CoinAppImpl::DrawStatistics()
+{
+    // appends to the frame timing window
+    if (ImGui::Begin("Frame Timings", &show_frame_timings)) {
+        ImGui::Separator();
+        ImGui::Text("field writes: %zu, suppressed: %zu",
+                    last_sync_stats.written, last_sync_stats.suppressed);
+        ImGui::Text("input: %zu moves coalesced, %zu captured by imgui",
+                    coalesced_moves, imgui_captured_events);
+        ImGui::Text("bounding box traversals: %zu", bbox_cache.recomputes);
+        ImGui::Text("ui hooks: %zu", ui_hooks.Size());
+        ImGui::Text("commands: %zu queued, %zu peak, %zu drained in %.3f ms",
+                    commands.GetDepth(), commands.GetPeakDepth(),
+                    commands.stats.drained, commands.stats.drain_ms);
+        auto &pump = sensor_pump.stats;
+        ImGui::Text("sensors: %zu queue passes, %.3f ms (%.3f ms "
+                    "unbudgeted)%s%s, %zu frames over budget",
+                    pump.queue_passes, pump.milliseconds, pump.unbudgeted_ms,
+                    pump.over_budget ? ", over budget" : "",
+                    pump.pending ? ", pending" : "",
+                    sensor_pump.over_budget_frames);
+        ImGui::Text("static layer: %zu renders, %zu reuses",
+                    static_layer.renders, static_layer.reuses);
+        constexpr const char *QualityModes[] = {"full", "complexity",
+                                                "resolution"};
+        ImGui::Text("quality: %s, scale %.3f%s, %zu refinements",
+                    QualityModes[static_cast<int>(quality.GetMode())],
+                    quality.GetScale(),
+                    quality.IsInteracting() ? " (interacting)" : "",
+                    quality.refinements);
+    }
+    ImGui::End();
+}
+
+void CoinAppImpl::DrawLoadingProgress()
+{
+    auto vp = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(
+        ImVec2(vp->WorkPos.x + vp->WorkSize.x * 0.5f,
+               vp->WorkPos.y + vp->WorkSize.y * 0.5f),
+        ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(320, 0));
+    ImGui::Begin("Loading", nullptr,
+                 ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove |
+                     ImGuiWindowFlags_NoSavedSettings);
+    ImGui::TextUnformatted(scene_loader.GetPath().c_str());
+    float progress = scene_loader.GetProgress();
+    if (progress < 0.f) {
+        // a mapped file gives no progress, newer imgui animates negative
+        // fractions
+        ImGui::ProgressBar(-float(ImGui::GetTime()), ImVec2(-1, 0),
+                           "reading");
+    } else {
+        ImGui::ProgressBar(progress, ImVec2(-1, 0));
+    }
+    ImGui::End();
+}
+
 void CoinAppImpl::ImGuiInit()
 {
     IMGUI_CHECKVERSION();
@@ -215,6 +1143,12 @@ void CoinAppImpl::ImGuiNewFrame()
 {
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
+    // the backend falls back to the live cursor of a focused window, the
+    // replayed position comes last and wins
+    if (!imgui_live_input && replay_cursor.first >= 0.0) {
+        ImGui::GetIO().AddMousePosEvent(float(replay_cursor.first),
+                                        float(replay_cursor.second));
+    }
     ImGui::NewFrame();
 
     ImGuizmo::BeginFrame();
@@ -237,59 +1171,23 @@ void CoinAppImpl::ImGuiDestroy()
     ImGui::DestroyContext();
 }
 
-void SoCallbackImGuiEventHandle(void *user, SoAction *action)
+void RenderCallback(void *user, SoRenderManager *manager)
 {
+    // the render manager calls this from its root sensor whenever the scene
+    // graph changed, i.e. the scene needs a redraw
     auto impl = static_cast<CoinAppImpl *>(user);
-    // if (action->isOfType(SoGLRenderAction::getClassTypeId())) {
-    //     // impl->ImGuiNewFrame();
-    //     impl->ImGuiDraw();
-    //     // impl->ImGuiRender();
-    //     return;
-    // }
-
-    if (action->isOfType(SoHandleEventAction::getClassTypeId())) {
-        auto handleEventAction = static_cast<SoHandleEventAction *>(action);
-        auto event = handleEventAction->getEvent();
-        bool isMouseButtonEvent =
-            event->isOfType(SoMouseButtonEvent::getClassTypeId());
-        bool isMouseMoveEvent =
-            event->isOfType(SoLocation2Event::getClassTypeId());
-        ImGuiIO &io = ImGui::GetIO();
-        if ((isMouseButtonEvent || isMouseMoveEvent) && io.WantCaptureMouse) {
-            handleEventAction->setHandled();
-        }
+    if (!impl->in_frame_sensors) {
+        impl->RequestRedraw(1);
     }
-
-    // if (action->isOfType(SoGetBoundingBoxAction::getClassTypeId())) {
-    //     auto getBoundingBoxAction =
-    //         static_cast<SoGetBoundingBoxAction *>(action);
-
-    //     ///@todo how to compute the exact gizmo bounding box ?
-    //     // the gizmo axes is 100pixels long in screen space
-    //     auto &modelMatrix = impl->modelMatrix;
-    //     auto minPt = modelMatrix[3];
-    //     auto maxPt = modelMatrix * glm::vec4(1, 1, 1, 1);
-
-    //     if
-    //     (impl->camera->isOfType(SoPerspectiveCamera::getClassTypeId())) {
-
-    //         auto cam = static_cast<SoPerspectiveCamera *>(impl->camera);
-    //         auto &vp = getBoundingBoxAction->getViewportRegion();
-    //         float fov = cam->heightAngle.getValue();
-    //         auto size = vp.getViewportSize();
-
-    //         float pixelWorldSize =
-    //             2.0f * glm::length(minPt) * tan(fov / 2.f) / size[1];
-    //         maxPt = modelMatrix * (pixelWorldSize * glm::vec4(1, 1, 1,
-    //         1));
-    //     }
-
-    //     SbBox3f box(minPt.x, minPt.y, minPt.z, maxPt.x, maxPt.y,
-    //     maxPt.z); getBoundingBoxAction->extendBy(box);
-    // }
 }
 
-void RenderCallback(void *user, SoRenderManager *manager) {}
+void DynamicLayerCallback(void *user, SoSensor *sensor)
+{
+    auto impl = static_cast<CoinAppImpl *>(user);
+    if (!impl->in_frame_sensors) {
+        impl->RequestRedraw(1);
+    }
+}
 
 SoCamera *SearchForCamera(SoNode *root)
 {
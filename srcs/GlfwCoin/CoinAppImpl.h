@@ -8,6 +8,21 @@
  */
 #pragma once
 
+#include <CoinApp.h>
+
+#include "AdaptiveQuality.h"
+#include "BoundingBoxCache.h"
+#include "CommandQueue.h"
+#include "EventCallback.h"
+#include "FieldSync.h"
+#include "FrameProfiler.h"
+#include "InputRecorder.h"
+#include "OffscreenTarget.h"
+#include "SceneLoader.h"
+#include "SensorPump.h"
+#include "StaticLayer.h"
+#include "UiHooks.h"
+
 #include <GLFW/glfw3.h>
 
 #include <Inventor/SoEventManager.h>
@@ -15,47 +30,154 @@
 #include <Inventor/events/SoLocation2Event.h>
 #include <Inventor/events/SoMouseButtonEvent.h>
 #include <Inventor/nodes/SoCamera.h>
+#include <Inventor/nodes/SoComplexity.h>
+#include <Inventor/nodes/SoGroup.h>
 #include <Inventor/nodes/SoSeparator.h>
 #include <Inventor/nodes/SoTransform.h>
+#include <Inventor/sensors/SoNodeSensor.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <cstddef>
 #include <functional>
 #include <utility>
+#include <vector>
 
 namespace zen
 {
 
 struct CoinAppImpl {
+    Backend backend{Backend::Window};
     GLFWwindow *window{nullptr};
+    OffscreenTarget offscreen;
     SoRenderManager *render_manager{nullptr};
     SoEventManager *event_manager{nullptr};
     SoCamera *camera{nullptr};
     SoSeparator *root{nullptr};
     SoTransform *gizmo_transform{nullptr};
+    // drawn every frame on top of the cached image of root. dynamic_root
+    // shares the light and the camera of root, event_root holds both roots
+    // for the event manager.
+    SoSeparator *dynamic_layers{nullptr};
+    SoSeparator *dynamic_root{nullptr};
+    SoGroup *event_root{nullptr};
+    SoNodeSensor dynamic_sensor;
+    StaticLayer static_layer;
+    bool static_layer_caching{true};
+    // of the window depth buffer, 0 if the cached depth cannot be blitted
+    // into it, queried on first use
+    GLenum window_depth_format{GLenum(-1)};
+
+    AdaptiveQuality quality;
+    // first child of root, only its value is applied
+    SoComplexity *complexity{nullptr};
+    // the window frame at the resolution scale of quality
+    OffscreenTarget scaled_target;
     SoMouseButtonEvent mouse_button_evt;
     SoLocation2Event location2_evt;
 
+    // input is queued by the glfw callbacks and dispatched once per frame,
+    // consecutive moves are merged into the latest one
+    std::vector<InputEvent> input_queue;
+    SbVec2s cursor_position{0, 0};
+    size_t coalesced_moves{0};
+    size_t imgui_captured_events{0};
+
     glm::mat4 view_matrix{1.0f};
     glm::mat4 projection_matrix{1.0f};
     glm::mat4 model_matrix{1.0f};
+    // the matrices as read from coin, the gizmos only moved something when
+    // they differ from these
+    glm::mat4 synced_view_matrix{1.0f};
+    glm::mat4 synced_model_matrix{1.0f};
+    FieldSyncStats sync_stats;
+    FieldSyncStats last_sync_stats;
 
     std::function<void()> imGuiCallback;
+    UiHookRegistry ui_hooks;
+
+    RenderMode render_mode{RenderMode::Continuous};
+    double max_frame_rate{0.0};
+    double last_frame_time{0.0};
+    // frames still owed in on-demand mode, imgui needs a few frames to settle
+    // hover/active states after an input event
+    int redraw_frames{1};
+    std::pair<int, int> viewport_size{0, 0};
+
+    FrameProfiler profiler;
+    bool show_frame_timings{false};
+
+    InputRecorder recorder;
+    InputReplayer replayer;
+    ReplayOptions replay_options;
+    double replay_start{0.0};
+    bool replay_frame_pending{false};
+    std::vector<FrameTiming> replay_timings;
+    // imgui is fed from the log while replaying, the live cursor would
+    // change what it captures
+    bool imgui_live_input{true};
+    std::pair<double, double> replay_cursor{-1.0, -1.0};
+
+    SceneLoader scene_loader;
+
+    SensorPump sensor_pump;
+    // the frame being drawn shows what its sensors change
+    bool in_frame_sensors{false};
+    // filled by worker threads, drained before the sensors
+    CommandQueue commands;
+
+    // feeds viewAll and the auto clipping instead of a bounding box
+    // traversal per frame
+    BoundingBoxCache bbox_cache;
+    // the layers share the camera and so its near and far planes
+    BoundingBoxCache layers_bbox_cache;
+    int depth_bits{0};
 
     CoinAppImpl();
     ~CoinAppImpl();
 
+    void SetSceneGraph(SoNode *scene);
+    void PollSceneLoader();
+
     void UpdateImGuizmo();
     void SyncImGuizmo();
 
     std::pair<int, int> GetWindowSize();
 
+    bool AcceptInput(const InputRecord &record);
+    void ReplayInput();
+    void ReplayToImGui(const InputRecord &record);
+    void SetImGuiLiveInput(bool enabled);
+    void FinishReplay();
+    void FinishFrame();
+
+    void PostCommand(Command command);
+    void QueueInput(const InputEvent &input);
+    void ProcessInput();
+
+    void RequestRedraw(int frames = 3);
+    double GetSensorTimeout();
+    bool AreSensorsDue();
+    void WaitEvents();
+    bool BeginFrame();
+
     void UpdateViewport();
-    void Render();
-    void IdleCallback();
+    void ViewAll();
+    void UpdateClippingPlanes();
+    void UpdateQuality();
+    /// into the bound target, the window if null
+    void Render(OffscreenTarget *target = nullptr);
+    void RenderLayers(OffscreenTarget *target);
+    GLenum GetWindowDepthFormat();
+    bool RenderOffscreen(int width, int height, unsigned char *rgba,
+                         float *depth);
+    void IdleCallback(bool budgeted = true);
+    void ProcessFrameSensors();
 
     void ImGuiDraw();
+    void DrawStatistics();
+    void DrawLoadingProgress();
     void ImGuiInit();
     void ImGuiNewFrame();
     void ImGuiRender();
@@ -64,8 +186,8 @@ struct CoinAppImpl {
 
 void RenderCallback(void *user, SoRenderManager *manager);
 
-SoCamera *SearchForCamera(SoNode *root);
+void DynamicLayerCallback(void *user, SoSensor *sensor);
 
-void SoCallbackImGuiEventHandle(void *user, SoAction *action);
+SoCamera *SearchForCamera(SoNode *root);
 
 } // namespace zen
\ No newline at end of file
@@ -0,0 +1,152 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file CommandQueue.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:19:04, October 17, 2026
+ */
+#include "CommandQueue.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/fields/SoMFVec3f.h>
+#include <Inventor/nodes/SoTransform.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace zen
+{
+CommandQueue::CommandQueue() : head(&stub), tail(&stub) {}
+
+CommandQueue::~CommandQueue()
+{
+    while (Node *node = Pop()) {
+        delete node;
+    }
+}
+
+bool CommandQueue::Push(Command command)
+{
+    auto node = new Node;
+    node->command = std::move(command);
+
+    size_t previous = depth.fetch_add(1, std::memory_order_relaxed);
+    size_t peak = peak_depth.load(std::memory_order_relaxed);
+    while (previous + 1 > peak &&
+           !peak_depth.compare_exchange_weak(peak, previous + 1,
+                                             std::memory_order_relaxed)) {
+    }
+
+    Link(node);
+    return previous == 0;
+}
+
+void CommandQueue::Link(Node *node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node *previous = head.exchange(node, std::memory_order_acq_rel);
+    // the list is broken between the exchange and this store, Pop sees an
+    // empty queue meanwhile
+    previous->next.store(node, std::memory_order_release);
+}
+
+CommandQueue::Node *CommandQueue::Pop()
+{
+    Node *first = tail;
+    Node *next = first->next.load(std::memory_order_acquire);
+    if (first == &stub) {
+        if (!next) {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        tail = next;
+        return first;
+    }
+    if (first != head.load(std::memory_order_acquire)) {
+        // a producer is in the middle of Link
+        return nullptr;
+    }
+    // first is the last node, the stub takes its place so it can go
+    Link(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
+
+void CommandQueue::Drain()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // commands posted while draining wait for the next frame, a fast
+    // producer cannot keep the render thread here
+    size_t count = depth.load(std::memory_order_acquire);
+    touched.clear();
+
+    // immediate sensors run once at endNotify instead of after every write
+    SoDB::startNotify();
+    size_t drained = 0;
+    for (; drained < count; ++drained) {
+        Node *node = Pop();
+        if (!node) {
+            break;
+        }
+
+        // the typed writes notify nothing here, every written node gets a
+        // single touch below
+        SoFieldContainer *container = nullptr;
+        SbBool notify = TRUE;
+        if (auto call = std::get_if<std::function<void()>>(&node->command)) {
+            if (*call) {
+                (*call)();
+            }
+        } else if (auto set = std::get_if<SetTranslationCommand>(
+                       &node->command)) {
+            container = set->transform;
+            notify = container->enableNotify(FALSE);
+            set->transform->translation.setValue(set->translation);
+        } else if (auto set =
+                       std::get_if<SetRotationCommand>(&node->command)) {
+            container = set->transform;
+            notify = container->enableNotify(FALSE);
+            set->transform->rotation.setValue(set->rotation);
+        } else if (auto set = std::get_if<SetValuesCommand>(&node->command)) {
+            container = set->field->getContainer();
+            if (container) {
+                notify = container->enableNotify(FALSE);
+            }
+            int num = int(set->values.size());
+            set->field->setValues(0, num, set->values.data());
+            set->field->setNum(num);
+        }
+
+        if (container) {
+            container->enableNotify(notify);
+            touched.push_back(container);
+        }
+        delete node;
+    }
+    depth.fetch_sub(drained, std::memory_order_relaxed);
+
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (auto container : touched) {
+        container->touch();
+    }
+    SoDB::endNotify();
+
+    stats.drained = drained;
+    stats.touched = touched.size();
+    stats.drain_ms = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+}
+
+} // namespace zen
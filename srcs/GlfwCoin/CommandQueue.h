@@ -0,0 +1,93 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file CommandQueue.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:19:04, October 17, 2026
+ */
+#pragma once
+
+#include <CoinApp.h>
+
+#include <Inventor/SbRotation.h>
+#include <Inventor/SbVec3f.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <variant>
+#include <vector>
+
+class SoFieldContainer;
+class SoMFVec3f;
+class SoTransform;
+
+namespace zen
+{
+
+struct SetTranslationCommand {
+    SoTransform *transform{nullptr};
+    SbVec3f translation;
+};
+
+struct SetRotationCommand {
+    SoTransform *transform{nullptr};
+    SbRotation rotation;
+};
+
+struct SetValuesCommand {
+    SoMFVec3f *field{nullptr};
+    std::vector<SbVec3f> values;
+};
+
+using Command = std::variant<std::function<void()>, SetTranslationCommand,
+                             SetRotationCommand, SetValuesCommand>;
+
+/// scene graph changes posted from any thread and applied on the render
+/// thread. Producers link their nodes into an intrusive list with one atomic
+/// exchange, the single consumer walks it from the other end, so neither
+/// side ever takes a lock.
+class CommandQueue
+{
+  public:
+    CommandQueue();
+    ~CommandQueue();
+
+    CommandQueue(const CommandQueue &) = delete;
+    CommandQueue &operator=(const CommandQueue &) = delete;
+
+    /// any thread, returns true if the queue was empty before
+    bool Push(Command command);
+
+    /// render thread only. Applies the commands posted before the call in
+    /// one notification batch, typed field writes notify their node once.
+    void Drain();
+
+    size_t GetDepth() const { return depth.load(std::memory_order_relaxed); }
+    size_t GetPeakDepth() const
+    {
+        return peak_depth.load(std::memory_order_relaxed);
+    }
+
+    /// of the last Drain, depth and peak_depth stay unset
+    CommandQueueStats stats;
+
+  private:
+    struct Node {
+        std::atomic<Node *> next{nullptr};
+        Command command;
+    };
+
+    void Link(Node *node);
+    Node *Pop();
+
+    std::atomic<Node *> head; // producers
+    Node *tail;               // consumer
+    Node stub;
+    std::atomic<size_t> depth{0};
+    std::atomic<size_t> peak_depth{0};
+    std::vector<SoFieldContainer *> touched; // kept for its capacity
+};
+
+} // namespace zen
@@ -20,6 +20,13 @@ namespace zen
 void framebufferSizeCallback(GLFWwindow *window, int w, int h)
 {
     auto impl = static_cast<CoinAppImpl *>(glfwGetWindowUserPointer(window));
+    if (!impl->AcceptInput(
+            {InputRecordType::FramebufferSize, 0.0, {w, h}})) {
+        return;
+    }
+    impl->viewport_size = {w, h};
+    impl->RequestRedraw();
+
     SbViewportRegion vp(w, h);
     if (impl->render_manager) {
         impl->render_manager->setViewportRegion(vp);
@@ -27,8 +34,9 @@ void framebufferSizeCallback(GLFWwindow *window, int w, int h)
     if (impl->event_manager) {
         impl->event_manager->setViewportRegion(vp);
     }
-    if (impl->camera) {
-        impl->camera->aspectRatio = float(w) / float(h);
+    if (impl->camera && h > 0) {
+        SyncField(impl->camera->aspectRatio, float(w) / float(h),
+                  impl->sync_stats);
     }
 }
 
@@ -36,6 +44,11 @@ void keyCallback(GLFWwindow *window, int key, int scancode, int action,
                  int mods)
 {
     auto impl = static_cast<CoinAppImpl *>(glfwGetWindowUserPointer(window));
+    if (!impl->AcceptInput(
+            {InputRecordType::Key, 0.0, {key, scancode, action, mods}})) {
+        return;
+    }
+    impl->RequestRedraw();
 
     SoKeyboardEvent event;
 
@@ -50,6 +63,11 @@ void keyCallback(GLFWwindow *window, int key, int scancode, int action,
     switch (key) {
     case GLFW_KEY_A: {
     } break;
+    case GLFW_KEY_F3: {
+        if (action == GLFW_PRESS) {
+            impl->show_frame_timings = !impl->show_frame_timings;
+        }
+    } break;
     default:
         break;
     }
@@ -58,67 +76,122 @@ void keyCallback(GLFWwindow *window, int key, int scancode, int action,
 void mouseClickCallback(GLFWwindow *window, int button, int action, int mods)
 {
     auto impl = static_cast<CoinAppImpl *>(glfwGetWindowUserPointer(window));
-
-    auto &event = impl->mouse_button_evt;
-
-    if (action == GLFW_PRESS) {
-        event.setState(SoButtonEvent::State::DOWN);
-    } else if (action == GLFW_RELEASE) {
-        event.setState(SoButtonEvent::State::UP);
-    } else {
-        event.setState(SoButtonEvent::State::UNKNOWN);
+    if (!impl->AcceptInput(
+            {InputRecordType::MouseButton, 0.0, {button, action, mods}})) {
+        return;
     }
+    impl->RequestRedraw();
 
-    event.setShiftDown(mods & GLFW_MOD_SHIFT);
-    event.setCtrlDown(mods & GLFW_MOD_CONTROL);
-    event.setAltDown(mods & GLFW_MOD_ALT);
-
-    switch (button) {
-    case GLFW_MOUSE_BUTTON_LEFT: {
-        event.setButton(SoMouseButtonEvent::BUTTON1);
-    } break;
-    case GLFW_MOUSE_BUTTON_RIGHT: {
-        event.setButton(SoMouseButtonEvent::BUTTON2);
-    } break;
-    case GLFW_MOUSE_BUTTON_MIDDLE: {
-        event.setButton(SoMouseButtonEvent::BUTTON3);
-    } break;
-    default: {
-        event.setButton(SoMouseButtonEvent::ANY);
-    } break;
-    }
+    InputEvent input;
+    input.type = InputEvent::Type::Button;
+    input.time = SbTime::getTimeOfDay();
+    input.position = impl->cursor_position;
+    input.button = button;
+    input.action = action;
+    input.mods = mods;
 
     SPDLOG_DEBUG("mouse click: {} {} {}", button, action, mods);
-    impl->event_manager->processEvent(&event);
+    impl->QueueInput(input);
 }
 
 void mouseMoveCallback(GLFWwindow *window, double xpos, double ypos)
 {
     auto impl = static_cast<CoinAppImpl *>(glfwGetWindowUserPointer(window));
+    if (!impl->AcceptInput(
+            {InputRecordType::MouseMove, 0.0, {}, {xpos, ypos}})) {
+        return;
+    }
+    impl->RequestRedraw();
 
     auto [width, height] = impl->GetWindowSize();
 
-    auto &event = impl->location2_evt;
     SbVec2s pos(static_cast<short>(xpos), static_cast<short>(height - ypos));
-    event.setPosition(pos);
-    impl->mouse_button_evt.setPosition(pos);
+    impl->cursor_position = pos;
+
+    InputEvent input;
+    input.type = InputEvent::Type::Move;
+    input.time = SbTime::getTimeOfDay();
+    input.position = pos;
 
     // SPDLOG_DEBUG("mouse move: {:.2f} {:.2f}", xpos, ypos);
-    impl->event_manager->processEvent(&event);
+    impl->QueueInput(input);
 }
 
 void mouseWheelCallback(GLFWwindow *window, double xoffset, double yoffset)
 {
     auto impl = static_cast<CoinAppImpl *>(glfwGetWindowUserPointer(window));
-    auto &event = impl->mouse_button_evt;
-    event.setState(SoButtonEvent::DOWN);
-    if (yoffset > 0) {
-        event.setButton(SoMouseButtonEvent::BUTTON4);
-    } else {
-        event.setButton(SoMouseButtonEvent::BUTTON5);
+    if (!impl->AcceptInput(
+            {InputRecordType::MouseWheel, 0.0, {}, {xoffset, yoffset}})) {
+        return;
     }
+    impl->RequestRedraw();
+
+    InputEvent input;
+    input.type = InputEvent::Type::Wheel;
+    input.time = SbTime::getTimeOfDay();
+    input.position = impl->cursor_position;
+    input.offset = yoffset;
 
-    impl->event_manager->processEvent(&event);
+    impl->QueueInput(input);
+}
+
+void dispatchInputEvent(CoinAppImpl *impl, const InputEvent &input)
+{
+    switch (input.type) {
+    case InputEvent::Type::Move: {
+        auto &event = impl->location2_evt;
+        event.setTime(input.time);
+        event.setPosition(input.position);
+        impl->event_manager->processEvent(&event);
+    } break;
+    case InputEvent::Type::Button: {
+        auto &event = impl->mouse_button_evt;
+        event.setTime(input.time);
+        event.setPosition(input.position);
+
+        if (input.action == GLFW_PRESS) {
+            event.setState(SoButtonEvent::State::DOWN);
+        } else if (input.action == GLFW_RELEASE) {
+            event.setState(SoButtonEvent::State::UP);
+        } else {
+            event.setState(SoButtonEvent::State::UNKNOWN);
+        }
+
+        event.setShiftDown(input.mods & GLFW_MOD_SHIFT);
+        event.setCtrlDown(input.mods & GLFW_MOD_CONTROL);
+        event.setAltDown(input.mods & GLFW_MOD_ALT);
+
+        switch (input.button) {
+        case GLFW_MOUSE_BUTTON_LEFT: {
+            event.setButton(SoMouseButtonEvent::BUTTON1);
+        } break;
+        case GLFW_MOUSE_BUTTON_RIGHT: {
+            event.setButton(SoMouseButtonEvent::BUTTON2);
+        } break;
+        case GLFW_MOUSE_BUTTON_MIDDLE: {
+            event.setButton(SoMouseButtonEvent::BUTTON3);
+        } break;
+        default: {
+            event.setButton(SoMouseButtonEvent::ANY);
+        } break;
+        }
+
+        impl->event_manager->processEvent(&event);
+    } break;
+    case InputEvent::Type::Wheel: {
+        auto &event = impl->mouse_button_evt;
+        event.setTime(input.time);
+        event.setPosition(input.position);
+        event.setState(SoButtonEvent::DOWN);
+        if (input.offset > 0) {
+            event.setButton(SoMouseButtonEvent::BUTTON4);
+        } else {
+            event.setButton(SoMouseButtonEvent::BUTTON5);
+        }
+
+        impl->event_manager->processEvent(&event);
+    } break;
+    }
 }
 
 } // namespace zen
\ No newline at end of file
@@ -9,8 +9,30 @@
 #pragma once
 #include <GLFW/glfw3.h>
 
+#include <Inventor/SbTime.h>
+#include <Inventor/SbVec2s.h>
+
 namespace zen
 {
+struct CoinAppImpl;
+
+/// glfw input recorded by the callbacks and dispatched to coin once per frame
+struct InputEvent {
+    enum class Type {
+        Move,
+        Button,
+        Wheel,
+    };
+
+    Type type{Type::Move};
+    SbTime time;
+    SbVec2s position; ///< coin window coordinates, origin at the bottom left
+    int button{0};
+    int action{0};
+    int mods{0};
+    double offset{0.0};
+};
+
 void framebufferSizeCallback(GLFWwindow *window, int w, int h);
 
 void keyCallback(GLFWwindow *window, int key, int scancode, int action,
@@ -22,4 +44,6 @@ void mouseMoveCallback(GLFWwindow *window, double xpos, double ypos);
 
 void mouseWheelCallback(GLFWwindow *window, double xoffset, double yoffset);
 
+void dispatchInputEvent(CoinAppImpl *impl, const InputEvent &input);
+
 } // namespace zen
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file FieldSync.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:30:49, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/fields/SoSFFloat.h>
+#include <Inventor/fields/SoSFRotation.h>
+#include <Inventor/fields/SoSFVec3f.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace zen
+{
+
+/// every field write notifies the auditors and invalidates the render caches
+/// above the node, even if the value did not change. These helpers only
+/// write on a real change and count the writes they saved.
+struct FieldSyncStats {
+    size_t written{0};
+    size_t suppressed{0};
+
+    void Reset() { written = suppressed = 0; }
+};
+
+constexpr float FieldSyncTolerance = 1e-5f;
+
+inline bool SyncField(SoSFFloat &field, float value, FieldSyncStats &stats,
+                      float tolerance = FieldSyncTolerance)
+{
+    float current = field.getValue();
+    if (std::fabs(current - value) <=
+        tolerance * std::max(1.f, std::fabs(current))) {
+        ++stats.suppressed;
+        return false;
+    }
+    field.setValue(value);
+    ++stats.written;
+    return true;
+}
+
+inline bool SyncField(SoSFVec3f &field, const SbVec3f &value,
+                      FieldSyncStats &stats,
+                      float tolerance = FieldSyncTolerance)
+{
+    const SbVec3f &current = field.getValue();
+    if ((current - value).length() <=
+        tolerance * std::max(1.f, current.length())) {
+        ++stats.suppressed;
+        return false;
+    }
+    field.setValue(value);
+    ++stats.written;
+    return true;
+}
+
+inline bool SyncField(SoSFRotation &field, const SbRotation &value,
+                      FieldSyncStats &stats,
+                      float tolerance = FieldSyncTolerance)
+{
+    // q and -q are the same rotation
+    const float *a = field.getValue().getValue();
+    const float *b = value.getValue();
+    float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+    float sign = dot < 0.f ? -1.f : 1.f;
+    float diff = 0.f;
+    for (int i = 0; i < 4; ++i) {
+        diff = std::max(diff, std::fabs(a[i] - sign * b[i]));
+    }
+    if (diff <= tolerance) {
+        ++stats.suppressed;
+        return false;
+    }
+    field.setValue(value);
+    ++stats.written;
+    return true;
+}
+
+} // namespace zen
@@ -0,0 +1,227 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file FrameProfiler.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:27:33, October 17, 2026
+ */
+#include "FrameProfiler.h"
+
+#include <imgui.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace zen
+{
+namespace
+{
+using Milliseconds = std::chrono::duration<double, std::milli>;
+using Seconds = std::chrono::duration<double>;
+
+FrameStatistics Summarize(std::vector<double> &values)
+{
+    FrameStatistics stats;
+    if (values.empty()) {
+        return stats;
+    }
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&](double p) {
+        size_t index = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+        return values[index];
+    };
+
+    double sum = 0.0;
+    for (double v : values) {
+        sum += v;
+    }
+
+    stats.min = values.front();
+    stats.avg = sum / values.size();
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    return stats;
+}
+} // namespace
+
+const char *ToString(FramePhase phase)
+{
+    switch (phase) {
+    case FramePhase::Events:
+        return "Events";
+    case FramePhase::Input:
+        return "Input";
+    case FramePhase::Commands:
+        return "Commands";
+    case FramePhase::Idle:
+        return "Idle";
+    case FramePhase::Render:
+        return "Render";
+    case FramePhase::ImGuiDraw:
+        return "ImGuiDraw";
+    case FramePhase::ImGuiRender:
+        return "ImGuiRender";
+    case FramePhase::SwapBuffers:
+        return "SwapBuffers";
+    default:
+        return "Unknown";
+    }
+}
+
+void FrameProfiler::BeginFrame()
+{
+    frame_start = Clock::now();
+    current.phases.fill(0.0);
+}
+
+void FrameProfiler::BeginPhase(FramePhase phase)
+{
+    phase_start[static_cast<size_t>(phase)] = Clock::now();
+}
+
+void FrameProfiler::EndPhase(FramePhase phase)
+{
+    auto index = static_cast<size_t>(phase);
+    current.phases[index] +=
+        Milliseconds(Clock::now() - phase_start[index]).count();
+}
+
+void FrameProfiler::EndFrame()
+{
+    auto now = Clock::now();
+    uint64_t frame = published.load(std::memory_order_relaxed);
+    current.frame = frame;
+    current.timestamp = Seconds(frame_start - origin).count();
+    current.total = Milliseconds(now - frame_start).count();
+
+    // odd sequence marks the slot as being written
+    auto &slot = slots[frame % Capacity];
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timing = current;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    published.store(frame + 1, std::memory_order_release);
+}
+
+std::vector<FrameTiming> FrameProfiler::GetFrames(size_t count) const
+{
+    uint64_t end = published.load(std::memory_order_acquire);
+    count = std::min({count, Capacity, static_cast<size_t>(end)});
+
+    std::vector<FrameTiming> frames;
+    frames.reserve(count);
+    for (uint64_t frame = end - count; frame < end; ++frame) {
+        auto &slot = slots[frame % Capacity];
+        uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        FrameTiming timing = slot.timing;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t after = slot.sequence.load(std::memory_order_relaxed);
+        // skip slots the writer touched while copying, they already belong
+        // to a newer frame
+        if (before == after && !(before & 1) && timing.frame == frame) {
+            frames.push_back(timing);
+        }
+    }
+    return frames;
+}
+
+std::array<FrameStatistics, FramePhaseCount + 1>
+FrameProfiler::GetStatistics(size_t count) const
+{
+    return ComputeStatistics(GetFrames(count));
+}
+
+std::string FrameProfiler::ToJson(size_t count) const
+{
+    return ToJson(GetFrames(count));
+}
+
+std::array<FrameStatistics, FramePhaseCount + 1>
+FrameProfiler::ComputeStatistics(const std::vector<FrameTiming> &frames)
+{
+    std::array<FrameStatistics, FramePhaseCount + 1> stats;
+    std::vector<double> values(frames.size());
+    for (size_t phase = 0; phase <= FramePhaseCount; ++phase) {
+        for (size_t i = 0; i < frames.size(); ++i) {
+            values[i] = phase < FramePhaseCount ? frames[i].phases[phase]
+                                                : frames[i].total;
+        }
+        stats[phase] = Summarize(values);
+    }
+    return stats;
+}
+
+std::string FrameProfiler::ToJson(const std::vector<FrameTiming> &frames)
+{
+    std::string json;
+    auto out = std::back_inserter(json);
+    fmt::format_to(out, "{{\"unit\":\"ms\",\"frames\":[");
+    for (size_t i = 0; i < frames.size(); ++i) {
+        auto &timing = frames[i];
+        fmt::format_to(out,
+                       "{}{{\"frame\":{},\"timestamp\":{:.6f},\"total\":{:.4f}",
+                       i ? "," : "", timing.frame, timing.timestamp,
+                       timing.total);
+        for (size_t phase = 0; phase < FramePhaseCount; ++phase) {
+            fmt::format_to(out, ",\"{}\":{:.4f}",
+                           ToString(static_cast<FramePhase>(phase)),
+                           timing.phases[phase]);
+        }
+        fmt::format_to(out, "}}");
+    }
+    fmt::format_to(out, "]}}");
+    return json;
+}
+
+void FrameProfiler::DrawHud(bool *open) const
+{
+    constexpr size_t window = 240;
+    auto stats = GetStatistics(window);
+
+    ImGui::SetNextWindowBgAlpha(0.75f);
+    if (!ImGui::Begin("Frame Timings", open,
+                      ImGuiWindowFlags_AlwaysAutoResize)) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("last %zu frames, milliseconds", window);
+    if (ImGui::BeginTable("phases", 5,
+                          ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Phase");
+        ImGui::TableSetupColumn("Min");
+        ImGui::TableSetupColumn("Avg");
+        ImGui::TableSetupColumn("P95");
+        ImGui::TableSetupColumn("P99");
+        ImGui::TableHeadersRow();
+
+        for (size_t phase = 0; phase <= FramePhaseCount; ++phase) {
+            auto &s = stats[phase];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(
+                phase < FramePhaseCount
+                    ? ToString(static_cast<FramePhase>(phase))
+                    : "Total");
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", s.min);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", s.avg);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", s.p95);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", s.p99);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+} // namespace zen
@@ -0,0 +1,109 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file FrameProfiler.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:27:33, October 17, 2026
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zen
+{
+
+enum class FramePhase : int {
+    Events,
+    Input,
+    Commands,
+    Idle,
+    Render,
+    ImGuiDraw,
+    ImGuiRender,
+    SwapBuffers,
+    Count,
+};
+
+constexpr size_t FramePhaseCount = static_cast<size_t>(FramePhase::Count);
+
+const char *ToString(FramePhase phase);
+
+struct FrameTiming {
+    uint64_t frame{0};
+    double timestamp{0.0}; ///< seconds since the profiler was created
+    double total{0.0};     ///< milliseconds
+    std::array<double, FramePhaseCount> phases{}; ///< milliseconds
+};
+
+struct FrameStatistics {
+    double min{0.0};
+    double avg{0.0};
+    double p95{0.0};
+    double p99{0.0};
+};
+
+/// per-phase timings of CoinApp::Run. The render thread is the single writer,
+/// finished frames are published into a ring buffer guarded by a per slot
+/// sequence counter, so readers never block the frame loop.
+class FrameProfiler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t Capacity = 1'024;
+
+    void BeginFrame();
+    void BeginPhase(FramePhase phase);
+    void EndPhase(FramePhase phase);
+    void EndFrame();
+
+    /// the last count published frames, oldest first
+    std::vector<FrameTiming> GetFrames(size_t count) const;
+    std::array<FrameStatistics, FramePhaseCount + 1>
+    GetStatistics(size_t count) const;
+    std::string ToJson(size_t count) const;
+
+    /// per phase statistics, the last entry summarizes the frame totals
+    static std::array<FrameStatistics, FramePhaseCount + 1>
+    ComputeStatistics(const std::vector<FrameTiming> &frames);
+    static std::string ToJson(const std::vector<FrameTiming> &frames);
+
+    void DrawHud(bool *open) const;
+
+  private:
+    struct Slot {
+        std::atomic<uint32_t> sequence{0};
+        FrameTiming timing;
+    };
+
+    std::array<Slot, Capacity> slots;
+    std::atomic<uint64_t> published{0};
+
+    FrameTiming current;
+    Clock::time_point origin{Clock::now()};
+    Clock::time_point frame_start;
+    std::array<Clock::time_point, FramePhaseCount> phase_start;
+};
+
+class ScopedFramePhase
+{
+  public:
+    ScopedFramePhase(FrameProfiler &profiler, FramePhase phase)
+        : profiler(profiler), phase(phase)
+    {
+        profiler.BeginPhase(phase);
+    }
+    ~ScopedFramePhase() { profiler.EndPhase(phase); }
+
+  private:
+    FrameProfiler &profiler;
+    FramePhase phase;
+};
+
+} // namespace zen
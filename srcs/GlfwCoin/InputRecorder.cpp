@@ -0,0 +1,197 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file InputRecorder.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:30:05, October 17, 2026
+ */
+#include "InputRecorder.h"
+
+#include <Inventor/nodes/SoOrthographicCamera.h>
+#include <Inventor/nodes/SoPerspectiveCamera.h>
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+
+namespace zen
+{
+namespace
+{
+constexpr char Magic[4] = {'Z', 'I', 'N', 'P'};
+constexpr uint32_t Version = 1;
+
+std::pair<int, int> PayloadSize(InputRecordType type)
+{
+    // number of int32 and double values following the timestamp
+    switch (type) {
+    case InputRecordType::FramebufferSize:
+        return {2, 0};
+    case InputRecordType::MouseButton:
+        return {3, 0};
+    case InputRecordType::MouseMove:
+    case InputRecordType::MouseWheel:
+        return {0, 2};
+    case InputRecordType::Key:
+        return {4, 0};
+    case InputRecordType::FrameEnd:
+    default:
+        return {0, 0};
+    }
+}
+
+template <typename T>
+void WriteValue(std::ofstream &stream, const T &value)
+{
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(std::ifstream &stream, T &value)
+{
+    return bool(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+} // namespace
+
+CameraState CameraState::FromCamera(SoCamera *camera)
+{
+    CameraState state;
+    if (!camera) {
+        return state;
+    }
+
+    camera->position.getValue().getValue(state.position[0], state.position[1],
+                                         state.position[2]);
+    camera->orientation.getValue().getValue(
+        state.orientation[0], state.orientation[1], state.orientation[2],
+        state.orientation[3]);
+    state.focal_distance = camera->focalDistance.getValue();
+    state.aspect_ratio = camera->aspectRatio.getValue();
+    if (camera->isOfType(SoPerspectiveCamera::getClassTypeId())) {
+        state.height =
+            static_cast<SoPerspectiveCamera *>(camera)->heightAngle.getValue();
+    } else if (camera->isOfType(SoOrthographicCamera::getClassTypeId())) {
+        state.height =
+            static_cast<SoOrthographicCamera *>(camera)->height.getValue();
+    }
+    return state;
+}
+
+void CameraState::ApplyTo(SoCamera *camera) const
+{
+    if (!camera) {
+        return;
+    }
+
+    camera->position.setValue(position[0], position[1], position[2]);
+    camera->orientation.setValue(orientation[0], orientation[1],
+                                 orientation[2], orientation[3]);
+    camera->focalDistance = focal_distance;
+    camera->aspectRatio = aspect_ratio;
+    if (camera->isOfType(SoPerspectiveCamera::getClassTypeId())) {
+        static_cast<SoPerspectiveCamera *>(camera)->heightAngle = height;
+    } else if (camera->isOfType(SoOrthographicCamera::getClassTypeId())) {
+        static_cast<SoOrthographicCamera *>(camera)->height = height;
+    }
+}
+
+bool InputRecorder::Open(const std::string &path, int width, int height,
+                         const CameraState &camera, double now)
+{
+    Close();
+
+    stream.open(path, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        SPDLOG_ERROR("failed to open input log for writing: {}", path);
+        return false;
+    }
+
+    start_time = now;
+    stream.write(Magic, sizeof(Magic));
+    WriteValue(stream, Version);
+    WriteValue(stream, int32_t(width));
+    WriteValue(stream, int32_t(height));
+    WriteValue(stream, camera);
+    return true;
+}
+
+void InputRecorder::Close()
+{
+    if (stream.is_open()) {
+        stream.close();
+    }
+}
+
+void InputRecorder::Write(const InputRecord &record, double now)
+{
+    auto [ints, doubles] = PayloadSize(record.type);
+    WriteValue(stream, record.type);
+    WriteValue(stream, now - start_time);
+    stream.write(reinterpret_cast<const char *>(record.ints),
+                 ints * sizeof(int32_t));
+    stream.write(reinterpret_cast<const char *>(record.doubles),
+                 doubles * sizeof(double));
+}
+
+bool InputReplayer::Open(const std::string &path)
+{
+    Close();
+
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        SPDLOG_ERROR("failed to open input log: {}", path);
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    int32_t w = 0, h = 0;
+    if (!stream.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+        !ReadValue(stream, version) || version != Version ||
+        !ReadValue(stream, w) || !ReadValue(stream, h) ||
+        !ReadValue(stream, camera)) {
+        SPDLOG_ERROR("not a valid input log: {}", path);
+        return false;
+    }
+    width = w;
+    height = h;
+
+    InputRecord record;
+    while (ReadValue(stream, record.type) && ReadValue(stream, record.time)) {
+        auto [ints, doubles] = PayloadSize(record.type);
+        stream.read(reinterpret_cast<char *>(record.ints),
+                    ints * sizeof(int32_t));
+        stream.read(reinterpret_cast<char *>(record.doubles),
+                    doubles * sizeof(double));
+        if (!stream) {
+            SPDLOG_WARN("truncated input log: {}", path);
+            break;
+        }
+        records.push_back(record);
+    }
+
+    active = true;
+    return true;
+}
+
+void InputReplayer::Close()
+{
+    records.clear();
+    cursor = 0;
+    active = false;
+    dispatching = false;
+}
+
+double InputReplayer::NextFrameTime() const
+{
+    for (size_t i = cursor; i < records.size(); ++i) {
+        if (records[i].type == InputRecordType::FrameEnd) {
+            return records[i].time;
+        }
+    }
+    return records.empty() ? 0.0 : records.back().time;
+}
+
+} // namespace zen
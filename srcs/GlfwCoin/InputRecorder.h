@@ -0,0 +1,85 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file InputRecorder.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:30:05, October 17, 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class SoCamera;
+
+namespace zen
+{
+
+enum class InputRecordType : uint8_t {
+    FramebufferSize,
+    MouseButton,
+    MouseMove,
+    MouseWheel,
+    Key,
+    FrameEnd, ///< a frame was rendered after the preceding records
+};
+
+/// one glfw callback invocation, the meaning of the payload depends on type
+struct InputRecord {
+    InputRecordType type{InputRecordType::FrameEnd};
+    double time{0.0}; ///< seconds since the recording started
+    int32_t ints[4]{};
+    double doubles[2]{};
+};
+
+struct CameraState {
+    float position[3]{};
+    float orientation[4]{0.f, 0.f, 0.f, 1.f};
+    float focal_distance{0.f};
+    float height{0.f}; ///< heightAngle of a perspective, height of an ortho
+    float aspect_ratio{1.f};
+
+    static CameraState FromCamera(SoCamera *camera);
+    void ApplyTo(SoCamera *camera) const;
+};
+
+/// writes the input log, the layout is a fixed header followed by records of
+/// a type byte, a double timestamp and a type dependent payload
+class InputRecorder
+{
+  public:
+    bool Open(const std::string &path, int width, int height,
+              const CameraState &camera, double now);
+    void Close();
+    bool IsOpen() const { return stream.is_open(); }
+    void Write(const InputRecord &record, double now);
+
+  private:
+    std::ofstream stream;
+    double start_time{0.0};
+};
+
+class InputReplayer
+{
+  public:
+    bool Open(const std::string &path);
+    void Close();
+    bool IsActive() const { return active; }
+    bool AtEnd() const { return cursor >= records.size(); }
+    /// recorded time of the next frame end, or of the last record
+    double NextFrameTime() const;
+
+    int width{0};
+    int height{0};
+    CameraState camera;
+    std::vector<InputRecord> records;
+    size_t cursor{0};
+    bool active{false};
+    bool dispatching{false};
+};
+
+} // namespace zen
@@ -0,0 +1,165 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file OffscreenTarget.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:26:37, October 17, 2026
+ */
+#include "OffscreenTarget.h"
+
+#include <spdlog/spdlog.h>
+
+#ifndef GL_FRAMEBUFFER_EXT
+#define GL_FRAMEBUFFER_EXT 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER_EXT
+#define GL_RENDERBUFFER_EXT 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0_EXT
+#define GL_COLOR_ATTACHMENT0_EXT 0x8CE0
+#endif
+#ifndef GL_DEPTH_ATTACHMENT_EXT
+#define GL_DEPTH_ATTACHMENT_EXT 0x8D00
+#endif
+#ifndef GL_READ_FRAMEBUFFER
+#define GL_READ_FRAMEBUFFER 0x8CA8
+#endif
+#ifndef GL_DRAW_FRAMEBUFFER
+#define GL_DRAW_FRAMEBUFFER 0x8CA9
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE_EXT
+#define GL_FRAMEBUFFER_COMPLETE_EXT 0x8CD5
+#endif
+
+namespace zen
+{
+OffscreenTarget::~OffscreenTarget() { Destroy(); }
+
+bool OffscreenTarget::Resize(const cc_glglue *gl, int w, int h)
+{
+    if (gl == glue && w == width && h == height && framebuffer) {
+        return true;
+    }
+
+    Destroy();
+
+    if (!gl || !cc_glglue_has_framebuffer_objects(gl)) {
+        SPDLOG_ERROR("framebuffer objects are not supported by this context");
+        return false;
+    }
+
+    glue = gl;
+    width = w;
+    height = h;
+
+    cc_glglue_glGenFramebuffers(glue, 1, &framebuffer);
+    cc_glglue_glBindFramebuffer(glue, GL_FRAMEBUFFER_EXT, framebuffer);
+
+    cc_glglue_glGenRenderbuffers(glue, 1, &color_buffer);
+    cc_glglue_glBindRenderbuffer(glue, GL_RENDERBUFFER_EXT, color_buffer);
+    cc_glglue_glRenderbufferStorage(glue, GL_RENDERBUFFER_EXT, GL_RGBA8, width,
+                                    height);
+    cc_glglue_glFramebufferRenderbuffer(glue, GL_FRAMEBUFFER_EXT,
+                                        GL_COLOR_ATTACHMENT0_EXT,
+                                        GL_RENDERBUFFER_EXT, color_buffer);
+
+    cc_glglue_glGenRenderbuffers(glue, 1, &depth_buffer);
+    cc_glglue_glBindRenderbuffer(glue, GL_RENDERBUFFER_EXT, depth_buffer);
+    cc_glglue_glRenderbufferStorage(glue, GL_RENDERBUFFER_EXT, depth_format,
+                                    width, height);
+    cc_glglue_glFramebufferRenderbuffer(glue, GL_FRAMEBUFFER_EXT,
+                                        GL_DEPTH_ATTACHMENT_EXT,
+                                        GL_RENDERBUFFER_EXT, depth_buffer);
+
+    cc_glglue_glBindRenderbuffer(glue, GL_RENDERBUFFER_EXT, 0);
+    GLenum status = cc_glglue_glCheckFramebufferStatus(glue, GL_FRAMEBUFFER_EXT);
+    cc_glglue_glBindFramebuffer(glue, GL_FRAMEBUFFER_EXT, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE_EXT) {
+        SPDLOG_ERROR("incomplete offscreen framebuffer {}x{}: {:#x}", width,
+                     height, status);
+        Destroy();
+        return false;
+    }
+    return true;
+}
+
+void OffscreenTarget::Bind()
+{
+    cc_glglue_glBindFramebuffer(glue, GL_FRAMEBUFFER_EXT, framebuffer);
+}
+
+void OffscreenTarget::Unbind()
+{
+    cc_glglue_glBindFramebuffer(glue, GL_FRAMEBUFFER_EXT, 0);
+}
+
+void OffscreenTarget::Destroy()
+{
+    if (!glue) {
+        return;
+    }
+
+    if (depth_buffer) {
+        cc_glglue_glDeleteRenderbuffers(glue, 1, &depth_buffer);
+    }
+    if (color_buffer) {
+        cc_glglue_glDeleteRenderbuffers(glue, 1, &color_buffer);
+    }
+    if (framebuffer) {
+        cc_glglue_glDeleteFramebuffers(glue, 1, &framebuffer);
+    }
+
+    glue = nullptr;
+    blit_framebuffer = nullptr;
+    framebuffer = color_buffer = depth_buffer = 0;
+    width = height = 0;
+}
+
+void OffscreenTarget::ReadColor(unsigned char *rgba)
+{
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+}
+
+void OffscreenTarget::ReadDepth(float *depth)
+{
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, depth);
+}
+
+bool OffscreenTarget::BlitTo(GLuint target_framebuffer, int target_width,
+                             int target_height, GLbitfield mask, GLenum filter)
+{
+    if (!framebuffer) {
+        return false;
+    }
+    if (!blit_framebuffer) {
+        // core since GL 3.0, coin does not wrap it
+        blit_framebuffer = reinterpret_cast<BlitFramebufferProc>(
+            cc_glglue_getprocaddress(glue, "glBlitFramebuffer"));
+        if (!blit_framebuffer) {
+            SPDLOG_ERROR("glBlitFramebuffer is not supported by this context");
+            return false;
+        }
+    }
+
+    cc_glglue_glBindFramebuffer(glue, GL_READ_FRAMEBUFFER, framebuffer);
+    cc_glglue_glBindFramebuffer(glue, GL_DRAW_FRAMEBUFFER, target_framebuffer);
+    while (glGetError() != GL_NO_ERROR) {
+    }
+    blit_framebuffer(0, 0, width, height, 0, 0, target_width, target_height,
+                     mask, filter);
+    GLenum error = glGetError();
+    cc_glglue_glBindFramebuffer(glue, GL_FRAMEBUFFER_EXT, target_framebuffer);
+
+    if (error != GL_NO_ERROR) {
+        SPDLOG_ERROR("blit {}x{} to {}x{} failed: {:#x}", width, height,
+                     target_width, target_height, error);
+        return false;
+    }
+    return true;
+}
+
+} // namespace zen
@@ -0,0 +1,51 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file OffscreenTarget.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:26:37, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/C/glue/gl.h>
+
+namespace zen
+{
+
+/// framebuffer object with color and depth renderbuffers, the GL entry
+/// points come from the coin glue so no extra loader is needed
+struct OffscreenTarget {
+    const cc_glglue *glue{nullptr};
+    GLuint framebuffer{0};
+    GLuint color_buffer{0};
+    GLuint depth_buffer{0};
+    int width{0};
+    int height{0};
+    /// takes effect when the buffers get created again
+    GLenum depth_format{0x81A6}; // GL_DEPTH_COMPONENT24
+
+    ~OffscreenTarget();
+
+    bool Resize(const cc_glglue *gl, int w, int h);
+    void Bind();
+    void Unbind();
+    void Destroy();
+
+    void ReadColor(unsigned char *rgba);
+    void ReadDepth(float *depth);
+
+    /// copies the buffers in mask into target_framebuffer, stretched to
+    /// target_width x target_height, and leaves it bound. Depth can only be
+    /// copied 1:1 into a depth buffer of the same format.
+    bool BlitTo(GLuint target_framebuffer, int target_width,
+                int target_height, GLbitfield mask, GLenum filter);
+
+  private:
+    using BlitFramebufferProc = void(APIENTRY *)(GLint, GLint, GLint, GLint,
+                                                 GLint, GLint, GLint, GLint,
+                                                 GLbitfield, GLenum);
+    BlitFramebufferProc blit_framebuffer{nullptr};
+};
+
+} // namespace zen
@@ -0,0 +1,742 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SceneCache.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:42:28, October 17, 2026
+ */
+#include "SceneCache.h"
+#include "SceneInput.h"
+
+#include <Inventor/SbColor.h>
+#include <Inventor/SbMatrix.h>
+#include <Inventor/SbName.h>
+#include <Inventor/SbRotation.h>
+#include <Inventor/SbString.h>
+#include <Inventor/SbVec2f.h>
+#include <Inventor/SbVec3d.h>
+#include <Inventor/SbVec3f.h>
+#include <Inventor/SbVec4f.h>
+#include <Inventor/fields/SoMFColor.h>
+#include <Inventor/fields/SoMFDouble.h>
+#include <Inventor/fields/SoMFFloat.h>
+#include <Inventor/fields/SoMFInt32.h>
+#include <Inventor/fields/SoMFMatrix.h>
+#include <Inventor/fields/SoMFNode.h>
+#include <Inventor/fields/SoMFRotation.h>
+#include <Inventor/fields/SoMFShort.h>
+#include <Inventor/fields/SoMFUInt32.h>
+#include <Inventor/fields/SoMFUShort.h>
+#include <Inventor/fields/SoMFVec2f.h>
+#include <Inventor/fields/SoMFVec3d.h>
+#include <Inventor/fields/SoMFVec3f.h>
+#include <Inventor/fields/SoMFVec4f.h>
+#include <Inventor/fields/SoSFNode.h>
+#include <Inventor/lists/SoFieldList.h>
+#include <Inventor/nodekits/SoBaseKit.h>
+#include <Inventor/nodes/SoFile.h>
+#include <Inventor/nodes/SoGroup.h>
+#include <Inventor/nodes/SoUnknownNode.h>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace zen
+{
+namespace
+{
+constexpr char Magic[4] = {'Z', 'S', 'C', 'N'};
+constexpr uint32_t NoIndex = ~0u;
+constexpr uint16_t IgnoredFlag = 1;
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t source_hash;
+    uint32_t node_count;
+    uint32_t field_count;
+    uint32_t child_count;
+    uint32_t string_count;
+    uint64_t nodes_offset;
+    uint64_t fields_offset;
+    uint64_t children_offset;
+    uint64_t strings_offset;
+};
+
+struct NodeRecord {
+    uint32_t type;
+    uint32_t name; ///< NoIndex for unnamed nodes
+    uint32_t first_field;
+    uint32_t field_count;
+    uint32_t first_child;
+    uint32_t child_count;
+};
+
+enum class FieldKind : uint16_t {
+    Array,    ///< raw values of a plain multiple-value field
+    Text,     ///< the ascii form of any other field
+    NodeRefs, ///< node table indices of a SoSFNode or SoMFNode
+};
+
+struct FieldRecord {
+    uint32_t name;
+    FieldKind kind;
+    uint16_t flags;
+    uint32_t count; ///< values of Array and NodeRefs
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size; ///< payload bytes
+};
+
+/// strings are stored zero terminated so SbName can read them in place
+struct StringRecord {
+    uint64_t offset;
+    uint32_t length;
+    uint32_t reserved;
+};
+
+/// the multiple-value fields copied as raw arrays
+struct ArrayCodec {
+    SoType type;
+    size_t element_size;
+    const void *(*data)(SoMField *field);
+    void (*set)(SoMField *field, const void *data, int count);
+};
+
+template <typename Field, typename Value>
+ArrayCodec MakeCodec()
+{
+    return {Field::getClassTypeId(), sizeof(Value),
+            [](SoMField *field) -> const void * {
+                return static_cast<Field *>(field)->getValues(0);
+            },
+            [](SoMField *field, const void *data, int count) {
+                auto mfield = static_cast<Field *>(field);
+                mfield->setNum(count);
+                mfield->setValues(0, count, static_cast<const Value *>(data));
+            }};
+}
+
+static_assert(sizeof(SbVec2f) == 8 && sizeof(SbVec3f) == 12 &&
+              sizeof(SbVec4f) == 16 && sizeof(SbVec3d) == 24 &&
+              sizeof(SbRotation) == 16 && sizeof(SbMatrix) == 64);
+
+const ArrayCodec *FindCodec(SoType type)
+{
+    // the type ids are only valid after SoDB::init
+    static const std::vector<ArrayCodec> codecs{
+        MakeCodec<SoMFFloat, float>(),
+        MakeCodec<SoMFDouble, double>(),
+        MakeCodec<SoMFInt32, int32_t>(),
+        MakeCodec<SoMFUInt32, uint32_t>(),
+        MakeCodec<SoMFShort, short>(),
+        MakeCodec<SoMFUShort, unsigned short>(),
+        MakeCodec<SoMFVec2f, SbVec2f>(),
+        MakeCodec<SoMFVec3f, SbVec3f>(),
+        MakeCodec<SoMFVec3d, SbVec3d>(),
+        MakeCodec<SoMFVec4f, SbVec4f>(),
+        MakeCodec<SoMFColor, SbColor>(),
+        MakeCodec<SoMFRotation, SbRotation>(),
+        MakeCodec<SoMFMatrix, SbMatrix>(),
+    };
+    for (const auto &codec : codecs) {
+        if (codec.type == type) {
+            return &codec;
+        }
+    }
+    return nullptr;
+}
+
+class CacheWriter
+{
+  public:
+    explicit CacheWriter(FILE *fp) : file(fp) {}
+
+    bool Write(SoNode *root, uint64_t source_hash)
+    {
+        CacheHeader header{};
+        WritePayload(&header, sizeof(header), 1);
+
+        uint32_t root_index = NoIndex;
+        if (!Visit(root, root_index)) {
+            return false;
+        }
+
+        std::vector<StringRecord> string_records;
+        string_records.reserve(strings.size());
+        for (const auto &str : strings) {
+            string_records.push_back(
+                {WritePayload(str.c_str(), str.size() + 1, 1),
+                 uint32_t(str.size()), 0});
+        }
+
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = SceneCacheVersion;
+        header.source_hash = source_hash;
+        header.node_count = uint32_t(nodes.size());
+        header.field_count = uint32_t(fields.size());
+        header.child_count = uint32_t(children.size());
+        header.string_count = uint32_t(strings.size());
+        header.nodes_offset = WriteTable(nodes);
+        header.fields_offset = WriteTable(fields);
+        header.children_offset = WriteTable(children);
+        header.strings_offset = WriteTable(string_records);
+
+        std::fseek(file, 0, SEEK_SET);
+        std::fwrite(&header, sizeof(header), 1, file);
+        return !std::ferror(file);
+    }
+
+    std::string error;
+
+  private:
+    template <typename T>
+    uint64_t WriteTable(const std::vector<T> &table)
+    {
+        return WritePayload(table.data(), table.size() * sizeof(T), 8);
+    }
+
+    uint64_t WritePayload(const void *data, size_t size, size_t alignment)
+    {
+        static const char zeros[16]{};
+        size_t padding = (alignment - position % alignment) % alignment;
+        std::fwrite(zeros, 1, padding, file);
+        position += padding;
+
+        uint64_t offset = position;
+        if (size > 0) {
+            std::fwrite(data, 1, size, file);
+            position += size;
+        }
+        return offset;
+    }
+
+    uint32_t Intern(const char *str)
+    {
+        auto [it, inserted] =
+            string_indices.try_emplace(str, uint32_t(strings.size()));
+        if (inserted) {
+            strings.emplace_back(str);
+        }
+        return it->second;
+    }
+
+    bool Visit(SoNode *node, uint32_t &index)
+    {
+        if (auto it = node_indices.find(node); it != node_indices.end()) {
+            index = it->second;
+            return true;
+        }
+
+        // nodekits rebuild their parts on their own, files pull in sources
+        // the hash does not cover and unknown nodes cannot be recreated
+        if (node->isOfType(SoBaseKit::getClassTypeId()) ||
+            node->isOfType(SoFile::getClassTypeId()) ||
+            node->isOfType(SoUnknownNode::getClassTypeId())) {
+            error = fmt::format("{} cannot be cached",
+                                node->getTypeId().getName().getString());
+            return false;
+        }
+
+        index = uint32_t(nodes.size());
+        node_indices.emplace(node, index);
+        nodes.emplace_back();
+
+        NodeRecord record{};
+        record.type = Intern(node->getTypeId().getName().getString());
+        SbName name = node->getName();
+        record.name = name.getLength() > 0 ? Intern(name.getString()) : NoIndex;
+
+        std::vector<FieldRecord> node_fields;
+        bool has_children_field = false;
+        SoFieldList list;
+        int count = node->getFields(list);
+        for (int i = 0; i < count; ++i) {
+            SoField *field = list[i];
+            SbName field_name;
+            node->getFieldName(field, field_name);
+            SoType type = field->getTypeId();
+
+            if (field->isConnected()) {
+                error = fmt::format("{}.{} is connected",
+                                    node->getTypeId().getName().getString(),
+                                    field_name.getString());
+                return false;
+            }
+            // vrml groups keep their children in a field
+            if (type == SoMFNode::getClassTypeId() &&
+                field_name == "children") {
+                has_children_field = true;
+            }
+            if (field->isDefault() && !field->isIgnored()) {
+                continue;
+            }
+
+            FieldRecord field_record{};
+            field_record.name = Intern(field_name.getString());
+            field_record.flags = field->isIgnored() ? IgnoredFlag : 0;
+
+            if (type.isDerivedFrom(SoSFNode::getClassTypeId()) ||
+                type.isDerivedFrom(SoMFNode::getClassTypeId())) {
+                std::vector<SoNode *> refs;
+                if (type.isDerivedFrom(SoSFNode::getClassTypeId())) {
+                    refs.push_back(static_cast<SoSFNode *>(field)->getValue());
+                } else {
+                    auto mfield = static_cast<SoMFNode *>(field);
+                    for (int j = 0; j < mfield->getNum(); ++j) {
+                        refs.push_back((*mfield)[j]);
+                    }
+                }
+
+                std::vector<uint32_t> ref_indices(refs.size(), NoIndex);
+                for (size_t j = 0; j < refs.size(); ++j) {
+                    if (refs[j] && !Visit(refs[j], ref_indices[j])) {
+                        return false;
+                    }
+                }
+                field_record.kind = FieldKind::NodeRefs;
+                field_record.count = uint32_t(ref_indices.size());
+                field_record.size = ref_indices.size() * sizeof(uint32_t);
+                field_record.offset = WritePayload(
+                    ref_indices.data(), size_t(field_record.size), 4);
+            } else if (auto codec = FindCodec(type)) {
+                auto mfield = static_cast<SoMField *>(field);
+                field_record.kind = FieldKind::Array;
+                field_record.count = uint32_t(mfield->getNum());
+                field_record.size = field_record.count * codec->element_size;
+                field_record.offset =
+                    WritePayload(field_record.count ? codec->data(mfield)
+                                                    : nullptr,
+                                 size_t(field_record.size), 16);
+            } else {
+                SbString text;
+                field->get(text);
+                field_record.kind = FieldKind::Text;
+                field_record.size = size_t(text.getLength());
+                field_record.offset = WritePayload(
+                    text.getString(), size_t(field_record.size), 1);
+            }
+            node_fields.push_back(field_record);
+        }
+
+        std::vector<uint32_t> node_children;
+        if (node->isOfType(SoGroup::getClassTypeId()) && !has_children_field) {
+            auto group = static_cast<SoGroup *>(node);
+            node_children.resize(size_t(group->getNumChildren()));
+            for (int i = 0; i < group->getNumChildren(); ++i) {
+                if (!Visit(group->getChild(i), node_children[size_t(i)])) {
+                    return false;
+                }
+            }
+        }
+
+        record.first_field = uint32_t(fields.size());
+        record.field_count = uint32_t(node_fields.size());
+        fields.insert(fields.end(), node_fields.begin(), node_fields.end());
+        record.first_child = uint32_t(children.size());
+        record.child_count = uint32_t(node_children.size());
+        children.insert(children.end(), node_children.begin(),
+                        node_children.end());
+        nodes[index] = record;
+        return true;
+    }
+
+    FILE *file;
+    uint64_t position{0};
+
+    std::unordered_map<SoNode *, uint32_t> node_indices;
+    std::unordered_map<std::string, uint32_t> string_indices;
+    std::vector<std::string> strings;
+    std::vector<NodeRecord> nodes;
+    std::vector<FieldRecord> fields;
+    std::vector<uint32_t> children;
+};
+
+class CacheReader
+{
+  public:
+    CacheReader(const char *data, size_t size) : data(data), size(size) {}
+
+    SoNode *Read(const std::string &path, uint64_t source_hash)
+    {
+        if (size < sizeof(CacheHeader)) {
+            return Fail(path, "truncated");
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+            return Fail(path, "not a scene cache");
+        }
+        if (header.version != SceneCacheVersion ||
+            header.source_hash != source_hash) {
+            SPDLOG_DEBUG("stale scene cache {}", path);
+            return nullptr;
+        }
+
+        nodes = Table<NodeRecord>(header.nodes_offset, header.node_count);
+        fields = Table<FieldRecord>(header.fields_offset, header.field_count);
+        children = Table<uint32_t>(header.children_offset, header.child_count);
+        auto strings =
+            Table<StringRecord>(header.strings_offset, header.string_count);
+        if (!nodes || !fields || !children || !strings ||
+            header.node_count == 0) {
+            return Fail(path, "bad table offsets");
+        }
+
+        names.reserve(header.string_count);
+        for (uint32_t i = 0; i < header.string_count; ++i) {
+            if (!InRange(strings[i].offset, uint64_t(strings[i].length) + 1)) {
+                return Fail(path, "bad string table");
+            }
+            names.emplace_back(data + strings[i].offset);
+        }
+
+        created.assign(header.node_count, nullptr);
+        bool ok = CreateNodes();
+        // link bottom up, the children come after their parents in the
+        // table and notifications stop at nodes without parents yet
+        for (uint32_t i = header.node_count; ok && i-- > 0;) {
+            ok = LinkNode(i);
+        }
+        if (!ok) {
+            for (auto node : created) {
+                if (node) {
+                    node->unref();
+                }
+            }
+            return Fail(path, error.c_str());
+        }
+
+        SoNode *root = created[0];
+        for (uint32_t i = 1; i < header.node_count; ++i) {
+            created[i]->unref();
+        }
+        root->unrefNoDelete();
+        return root;
+    }
+
+  private:
+    SoNode *Fail(const std::string &path, const char *reason)
+    {
+        SPDLOG_WARN("ignoring scene cache {}: {}", path, reason);
+        return nullptr;
+    }
+
+    bool InRange(uint64_t offset, uint64_t bytes) const
+    {
+        return offset <= size && bytes <= size - offset;
+    }
+
+    template <typename T>
+    const T *Table(uint64_t offset, uint32_t count) const
+    {
+        if (offset % alignof(T) != 0 ||
+            !InRange(offset, uint64_t(count) * sizeof(T))) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T *>(data + offset);
+    }
+
+    const SbName *Name(uint32_t index) const
+    {
+        return index < names.size() ? &names[index] : nullptr;
+    }
+
+    bool CreateNodes()
+    {
+        for (uint32_t i = 0; i < header.node_count; ++i) {
+            const NodeRecord &record = nodes[i];
+            auto type_name = Name(record.type);
+            SoType type =
+                type_name ? SoType::fromName(*type_name) : SoType::badType();
+            if (type.isBad() || !type.canCreateInstance() ||
+                !type.isDerivedFrom(SoNode::getClassTypeId())) {
+                error = fmt::format("unknown node type in entry {}", i);
+                return false;
+            }
+
+            auto node = static_cast<SoNode *>(type.createInstance());
+            node->ref();
+            created[i] = node;
+            if (auto name = Name(record.name)) {
+                node->setName(*name);
+            }
+
+            if (uint64_t(record.first_field) + record.field_count >
+                header.field_count) {
+                error = "bad field range";
+                return false;
+            }
+
+            node->enableNotify(FALSE);
+            bool ok = true;
+            for (uint32_t j = 0; ok && j < record.field_count; ++j) {
+                ok = SetField(node, fields[record.first_field + j]);
+            }
+            node->enableNotify(TRUE);
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool SetField(SoNode *node, const FieldRecord &record)
+    {
+        auto name = Name(record.name);
+        SoField *field = name ? node->getField(*name) : nullptr;
+        if (!field || !InRange(record.offset, record.size)) {
+            error = fmt::format("bad field {}",
+                                name ? name->getString() : "<unnamed>");
+            return false;
+        }
+
+        const char *payload = data + record.offset;
+        switch (record.kind) {
+        case FieldKind::Array: {
+            auto codec = FindCodec(field->getTypeId());
+            if (!codec || record.size != record.count * codec->element_size) {
+                error = fmt::format("bad array {}", name->getString());
+                return false;
+            }
+            codec->set(static_cast<SoMField *>(field), payload,
+                       int(record.count));
+            break;
+        }
+        case FieldKind::Text:
+            if (!field->set(std::string(payload, size_t(record.size)).c_str())) {
+                error = fmt::format("bad value of {}", name->getString());
+                return false;
+            }
+            break;
+        case FieldKind::NodeRefs:
+            // set once all nodes exist
+            break;
+        default:
+            error = "bad field kind";
+            return false;
+        }
+
+        if (record.flags & IgnoredFlag) {
+            field->setIgnored(TRUE);
+        }
+        return true;
+    }
+
+    SoNode *NodeAt(uint32_t index, bool &ok) const
+    {
+        if (index == NoIndex) {
+            return nullptr;
+        }
+        if (index >= created.size()) {
+            ok = false;
+            return nullptr;
+        }
+        return created[index];
+    }
+
+    bool LinkNode(uint32_t index)
+    {
+        SoNode *node = created[index];
+        const NodeRecord &record = nodes[index];
+        bool ok = true;
+
+        for (uint32_t j = 0; ok && j < record.field_count; ++j) {
+            const FieldRecord &field_record = fields[record.first_field + j];
+            if (field_record.kind != FieldKind::NodeRefs) {
+                continue;
+            }
+            if (field_record.size != field_record.count * sizeof(uint32_t)) {
+                ok = false;
+                break;
+            }
+            SoField *field = node->getField(*Name(field_record.name));
+            const uint32_t *refs =
+                reinterpret_cast<const uint32_t *>(data + field_record.offset);
+            if (field->isOfType(SoSFNode::getClassTypeId()) &&
+                field_record.count == 1) {
+                static_cast<SoSFNode *>(field)->setValue(NodeAt(refs[0], ok));
+            } else if (field->isOfType(SoMFNode::getClassTypeId())) {
+                auto mfield = static_cast<SoMFNode *>(field);
+                mfield->setNum(int(field_record.count));
+                for (uint32_t k = 0; ok && k < field_record.count; ++k) {
+                    mfield->set1Value(int(k), NodeAt(refs[k], ok));
+                }
+            } else {
+                ok = false;
+            }
+        }
+
+        if (record.child_count > 0) {
+            if (!node->isOfType(SoGroup::getClassTypeId()) ||
+                uint64_t(record.first_child) + record.child_count >
+                    header.child_count) {
+                ok = false;
+            }
+            auto group = static_cast<SoGroup *>(node);
+            for (uint32_t j = 0; ok && j < record.child_count; ++j) {
+                SoNode *child = NodeAt(children[record.first_child + j], ok);
+                if (!child) {
+                    ok = false;
+                    break;
+                }
+                group->addChild(child);
+            }
+        }
+
+        if (!ok) {
+            error = fmt::format("bad references in entry {}", index);
+        }
+        return ok;
+    }
+
+    const char *data;
+    size_t size;
+    CacheHeader header{};
+    const NodeRecord *nodes{nullptr};
+    const FieldRecord *fields{nullptr};
+    const uint32_t *children{nullptr};
+    std::vector<SbName> names;
+    std::vector<SoNode *> created;
+    std::string error;
+};
+} // namespace
+
+uint64_t HashSceneFile(const std::string &path)
+{
+    FILE *fp = std::fopen(path.c_str(), "rb");
+    if (!fp) {
+        return 0;
+    }
+
+    // word at a time multiply-xorshift, fast enough to stay far below the
+    // cost of parsing the file
+    constexpr uint64_t Prime = 0x9E3779B97F4A7C15ull;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    uint64_t total = 0;
+    std::vector<char> buffer(size_t(1) << 20);
+    size_t n = 0;
+    while ((n = std::fread(buffer.data(), 1, buffer.size(), fp)) > 0) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, buffer.data() + i, 8);
+            hash = (hash ^ word) * Prime;
+            hash ^= hash >> 29;
+        }
+        for (; i < n; ++i) {
+            hash = (hash ^ uint8_t(buffer[i])) * Prime;
+        }
+        total += n;
+    }
+    bool failed = std::ferror(fp);
+    std::fclose(fp);
+    if (failed) {
+        return 0;
+    }
+
+    hash = (hash ^ total) * Prime;
+    hash ^= hash >> 32;
+    // 0 is reserved for unreadable files
+    return hash ? hash : 1;
+}
+
+uint64_t SceneFileKey(const std::string &path)
+{
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    fs::path absolute = fs::weakly_canonical(path, ec);
+    if (ec) {
+        return 0;
+    }
+    auto size = fs::file_size(absolute, ec);
+    if (ec) {
+        return 0;
+    }
+    auto mtime = fs::last_write_time(absolute, ec);
+    if (ec) {
+        return 0;
+    }
+
+    constexpr uint64_t Prime = 0x9E3779B97F4A7C15ull;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : absolute.generic_string()) {
+        hash = (hash ^ uint8_t(c)) * Prime;
+    }
+    for (uint64_t word : {uint64_t(size),
+                          uint64_t(mtime.time_since_epoch().count())}) {
+        hash = (hash ^ word) * Prime;
+        hash ^= hash >> 29;
+    }
+    hash ^= hash >> 32;
+    return hash ? hash : 1;
+}
+
+std::string DefaultSceneCacheDirectory()
+{
+    std::error_code ec;
+    auto temp = std::filesystem::temp_directory_path(ec);
+    return ec ? std::string() : (temp / "CoinAppSceneCache").string();
+}
+
+std::string SceneCachePath(const std::string &directory, uint64_t key)
+{
+    return (std::filesystem::path(directory) /
+            fmt::format("{:016x}.zscene", key))
+        .string();
+}
+
+bool WriteSceneCache(SoNode *root, const std::string &path,
+                     uint64_t source_hash)
+{
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    fs::path target(path);
+    if (target.has_parent_path()) {
+        fs::create_directories(target.parent_path(), ec);
+    }
+
+    // write aside and rename, a reader never sees a half written cache
+    std::string temp_path = path + ".tmp";
+    FILE *fp = std::fopen(temp_path.c_str(), "wb");
+    if (!fp) {
+        SPDLOG_WARN("failed to create scene cache {}", temp_path);
+        return false;
+    }
+
+    CacheWriter writer(fp);
+    bool ok = writer.Write(root, source_hash);
+    ok = std::fclose(fp) == 0 && ok;
+    if (ok) {
+        fs::rename(temp_path, target, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        SPDLOG_WARN("scene cache {} not written: {}", path,
+                    writer.error.empty() ? "io error" : writer.error);
+        fs::remove(temp_path, ec);
+    }
+    return ok;
+}
+
+SoNode *ReadSceneCache(const std::string &path, uint64_t source_hash)
+{
+    MappedFile mapping;
+    if (!mapping.Open(path)) {
+        return nullptr;
+    }
+    CacheReader reader(mapping.Data(), mapping.Size());
+    return reader.Read(path, source_hash);
+}
+
+} // namespace zen
@@ -0,0 +1,50 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SceneCache.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:42:28, October 17, 2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+class SoNode;
+
+namespace zen
+{
+
+/// binary snapshot of a scene graph. The cache file is named after the
+/// path, size and modification time of the source, so a changed source
+/// finds no candidate without being read. A candidate is confirmed against
+/// the content hash stored in its header. The file holds a node table, a field table, the child lists and an
+/// interned string table, the multiple-value fields of plain types are
+/// stored as raw arrays and copied into the fields in one go on load.
+/// Fields of other types fall back to their ascii form. Scenes with engines
+/// or field connections, nodekits and unknown node types are not cached.
+constexpr uint32_t SceneCacheVersion = 1;
+
+/// 64 bit content hash of a file, 0 if it cannot be read
+uint64_t HashSceneFile(const std::string &path);
+
+/// 64 bit hash of the absolute path, the size and the modification time of
+/// a file, 0 if it does not exist. Only stats the file.
+uint64_t SceneFileKey(const std::string &path);
+
+/// a folder below the system temp directory, empty if there is none
+std::string DefaultSceneCacheDirectory();
+
+/// cache file of a SceneFileKey inside directory
+std::string SceneCachePath(const std::string &directory, uint64_t key);
+
+/// the graph must not be modified while it is written
+bool WriteSceneCache(SoNode *root, const std::string &path,
+                     uint64_t source_hash);
+
+/// null if the file is missing, stale or broken. Like SoDB::readAll the
+/// returned root is not referenced.
+SoNode *ReadSceneCache(const std::string &path, uint64_t source_hash);
+
+} // namespace zen
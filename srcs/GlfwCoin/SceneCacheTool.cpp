@@ -0,0 +1,86 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SceneCacheTool.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:42:28, October 17, 2026
+ */
+#include "SceneCache.h"
+#include "SceneInput.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/nodekits/SoNodeKit.h>
+#include <Inventor/nodes/SoNode.h>
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <print>
+#include <string>
+
+// usage: SceneCacheTool <scene> [cache directory]
+// parses the scene, stores its binary cache where CoinApp::LoadSceneAsync
+// looks for it and reads the cache back to compare the load times
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        spdlog::error("usage: SceneCacheTool <scene> [cache directory]");
+        return EXIT_FAILURE;
+    }
+    std::string path = argv[1];
+    std::string directory =
+        argc > 2 ? argv[2] : zen::DefaultSceneCacheDirectory();
+
+    SoDB::init();
+    SoNodeKit::init();
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    auto start = Clock::now();
+    uint64_t hash = zen::HashSceneFile(path);
+    if (!hash) {
+        spdlog::error("failed to read {}", path);
+        return EXIT_FAILURE;
+    }
+    double hash_time = seconds(start);
+
+    start = Clock::now();
+    SoNode *scene = zen::ReadScene(path);
+    if (!scene) {
+        spdlog::error("failed to parse {}", path);
+        return EXIT_FAILURE;
+    }
+    scene->ref();
+    double parse_time = seconds(start);
+
+    std::string cache_path =
+        zen::SceneCachePath(directory, zen::SceneFileKey(path));
+    start = Clock::now();
+    bool written = zen::WriteSceneCache(scene, cache_path, hash);
+    double write_time = seconds(start);
+    scene->unref();
+    if (!written) {
+        return EXIT_FAILURE;
+    }
+
+    start = Clock::now();
+    SoNode *cached = zen::ReadSceneCache(cache_path, hash);
+    double read_time = seconds(start);
+    if (!cached) {
+        spdlog::error("failed to read back {}", cache_path);
+        return EXIT_FAILURE;
+    }
+    cached->ref();
+    cached->unref();
+
+    std::println("{} -> {}", path, cache_path);
+    std::println("hash {:.3f}s, parse {:.3f}s, write {:.3f}s, cached load "
+                 "{:.3f}s",
+                 hash_time, parse_time, write_time, read_time);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,600 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SceneInput.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:38:06, October 17, 2026
+ */
+#include "SceneInput.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/SoInput.h>
+#include <Inventor/nodes/SoSeparator.h>
+
+#include <spdlog/spdlog.h>
+
+#ifdef COINAPP_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef COINAPP_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace zen
+{
+namespace
+{
+// size of the decompressed window, the only buffer the data passes through
+constexpr size_t ChunkSize = size_t(1) << 20;
+
+using ConsumedCounter = std::shared_ptr<std::atomic<size_t>>;
+
+bool HasSuffix(std::string_view str, std::string_view suffix)
+{
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/// produces the decompressed bytes in order and counts the compressed bytes
+/// it consumed
+class Decompressor
+{
+  public:
+    explicit Decompressor(ConsumedCounter counter)
+        : consumed(std::move(counter))
+    {
+    }
+    virtual ~Decompressor() = default;
+
+    /// up to size bytes, 0 at the end of the stream, negative on error
+    virtual ptrdiff_t Read(char *data, size_t size) = 0;
+
+  protected:
+    ConsumedCounter consumed;
+};
+
+#ifdef COINAPP_WITH_ZLIB
+class GzipDecompressor : public Decompressor
+{
+  public:
+    GzipDecompressor(gzFile gz, ConsumedCounter counter)
+        : Decompressor(std::move(counter)), file(gz)
+    {
+        gzbuffer(file, unsigned(ChunkSize));
+    }
+    ~GzipDecompressor() override { gzclose(file); }
+
+    ptrdiff_t Read(char *data, size_t size) override
+    {
+        int n = gzread(file, data, unsigned(std::min(size, size_t(INT_MAX))));
+        consumed->store(size_t(std::max<z_off_t>(0, gzoffset(file))));
+        if (n < 0) {
+            int code = 0;
+            SPDLOG_ERROR("gzip: {}", gzerror(file, &code));
+        }
+        return n;
+    }
+
+  private:
+    gzFile file;
+};
+#endif
+
+#ifdef COINAPP_WITH_ZSTD
+class ZstdDecompressor : public Decompressor
+{
+  public:
+    ZstdDecompressor(FILE *fp, ConsumedCounter counter)
+        : Decompressor(std::move(counter)), file(fp),
+          stream(ZSTD_createDStream()), input(ZSTD_DStreamInSize())
+    {
+        ZSTD_initDStream(stream);
+    }
+    ~ZstdDecompressor() override
+    {
+        ZSTD_freeDStream(stream);
+        std::fclose(file);
+    }
+
+    ptrdiff_t Read(char *data, size_t size) override
+    {
+        ZSTD_outBuffer out{data, size, 0};
+        while (out.pos == 0) {
+            bool at_end = false;
+            if (in.pos == in.size) {
+                size_t n = std::fread(input.data(), 1, input.size(), file);
+                if (n == 0) {
+                    if (std::ferror(file)) {
+                        return -1;
+                    }
+                    // flush what the stream still holds
+                    at_end = true;
+                }
+                total += n;
+                consumed->store(total);
+                in = {input.data(), n, 0};
+            }
+
+            size_t ret = ZSTD_decompressStream(stream, &out, &in);
+            if (ZSTD_isError(ret)) {
+                SPDLOG_ERROR("zstd: {}", ZSTD_getErrorName(ret));
+                return -1;
+            }
+            if (at_end) {
+                break;
+            }
+        }
+        return ptrdiff_t(out.pos);
+    }
+
+  private:
+    FILE *file;
+    ZSTD_DStream *stream;
+    std::vector<char> input;
+    ZSTD_inBuffer in{nullptr, 0, 0};
+    size_t total{0};
+};
+#endif
+
+/// bounded window over the decompressed data. Coin peeks at the first bytes
+/// of a FILE and seeks back, so seeks inside the current chunk are allowed.
+struct ChunkStream {
+    std::unique_ptr<Decompressor> decompressor;
+    std::vector<char> window = std::vector<char>(ChunkSize);
+    // logical offsets in the decompressed data
+    size_t window_start{0};
+    size_t window_end{0};
+    size_t position{0};
+    bool failed{false};
+
+    ptrdiff_t Read(char *data, size_t size)
+    {
+        if (position >= window_end) {
+            if (failed) {
+                return -1;
+            }
+            ptrdiff_t n = decompressor->Read(window.data(), window.size());
+            if (n < 0) {
+                failed = true;
+                return -1;
+            }
+            window_start = window_end;
+            window_end += size_t(n);
+            if (n == 0) {
+                return 0;
+            }
+        }
+
+        size_t n = std::min(size, window_end - position);
+        std::memcpy(data, window.data() + (position - window_start), n);
+        position += n;
+        return ptrdiff_t(n);
+    }
+
+    bool Seek(long long offset, int whence, long long &result)
+    {
+        long long target = -1;
+        if (whence == SEEK_SET) {
+            target = offset;
+        } else if (whence == SEEK_CUR) {
+            target = (long long)(position) + offset;
+        }
+        if (target < (long long)(window_start) ||
+            target > (long long)(window_end)) {
+            return false;
+        }
+        position = size_t(target);
+        result = target;
+        return true;
+    }
+};
+
+/// a mapped file read in place, counting the bytes the parser took
+struct MappedStream {
+    const char *data{nullptr};
+    size_t size{0};
+    size_t position{0};
+    ConsumedCounter consumed;
+
+    ptrdiff_t Read(char *out, size_t count)
+    {
+        size_t n = std::min(count, size - position);
+        std::memcpy(out, data + position, n);
+        position += n;
+        consumed->store(position);
+        return ptrdiff_t(n);
+    }
+
+    bool Seek(long long offset, int whence, long long &result)
+    {
+        long long target = -1;
+        if (whence == SEEK_SET) {
+            target = offset;
+        } else if (whence == SEEK_CUR) {
+            target = (long long)(position) + offset;
+        } else if (whence == SEEK_END) {
+            target = (long long)(size) + offset;
+        }
+        if (target < 0 || target > (long long)(size)) {
+            return false;
+        }
+        position = size_t(target);
+        result = target;
+        return true;
+    }
+};
+
+#if defined(__GLIBC__)
+template <class Stream>
+ssize_t CookieRead(void *cookie, char *data, size_t size)
+{
+    return static_cast<Stream *>(cookie)->Read(data, size);
+}
+
+template <class Stream>
+int CookieSeek(void *cookie, off64_t *offset, int whence)
+{
+    long long result = 0;
+    if (!static_cast<Stream *>(cookie)->Seek(*offset, whence, result)) {
+        return -1;
+    }
+    *offset = result;
+    return 0;
+}
+
+template <class Stream> int CookieClose(void *cookie)
+{
+    delete static_cast<Stream *>(cookie);
+    return 0;
+}
+
+template <class Stream> FILE *OpenCookieStream(Stream *stream)
+{
+    cookie_io_functions_t io{CookieRead<Stream>, nullptr, CookieSeek<Stream>,
+                             CookieClose<Stream>};
+    FILE *fp = fopencookie(stream, "rb", io);
+    if (!fp) {
+        delete stream;
+    }
+    return fp;
+}
+#elif defined(__APPLE__) || defined(__FreeBSD__)
+template <class Stream> int CookieRead(void *cookie, char *data, int size)
+{
+    return int(static_cast<Stream *>(cookie)->Read(data, size_t(size)));
+}
+
+template <class Stream>
+fpos_t CookieSeek(void *cookie, fpos_t offset, int whence)
+{
+    long long result = 0;
+    if (!static_cast<Stream *>(cookie)->Seek(offset, whence, result)) {
+        return -1;
+    }
+    return fpos_t(result);
+}
+
+template <class Stream> int CookieClose(void *cookie)
+{
+    delete static_cast<Stream *>(cookie);
+    return 0;
+}
+
+template <class Stream> FILE *OpenCookieStream(Stream *stream)
+{
+    FILE *fp = funopen(stream, CookieRead<Stream>, nullptr,
+                       CookieSeek<Stream>, CookieClose<Stream>);
+    if (!fp) {
+        delete stream;
+    }
+    return fp;
+}
+#endif
+
+#if defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+FILE *OpenChunkStream(ChunkStream *chunks) { return OpenCookieStream(chunks); }
+
+FILE *OpenMappedStream(MappedStream *mapped)
+{
+    FILE *fp = OpenCookieStream(mapped);
+    // unbuffered, coin reads large blocks and every one is copied straight
+    // from the mapping into its own buffer
+    if (fp) {
+        std::setvbuf(fp, nullptr, _IONBF, 0);
+    }
+    return fp;
+}
+#else
+FILE *OpenMappedStream(MappedStream *mapped)
+{
+    // SoInput reads the mapping as a buffer, without a count
+    delete mapped;
+    return nullptr;
+}
+
+FILE *OpenChunkStream(ChunkStream *chunks)
+{
+    // no custom stdio streams here, spool the decompressed data into a
+    // temporary file chunk by chunk instead
+    std::unique_ptr<ChunkStream> owner(chunks);
+    FILE *fp = std::tmpfile();
+    if (!fp) {
+        return nullptr;
+    }
+
+    ptrdiff_t n = 0;
+    while ((n = chunks->Read(chunks->window.data(), ChunkSize)) > 0) {
+        std::fwrite(chunks->window.data(), 1, size_t(n), fp);
+    }
+    if (n < 0) {
+        std::fclose(fp);
+        return nullptr;
+    }
+    std::rewind(fp);
+    return fp;
+}
+#endif
+} // namespace
+
+bool MappedFile::Open(const std::string &path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void *view =
+        mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        SPDLOG_WARN("failed to map {}", path);
+        return false;
+    }
+    file_handle = file;
+    mapping_handle = mapping;
+    size = size_t(file_size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void *view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE,
+                      fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        SPDLOG_WARN("failed to map {}", path);
+        return false;
+    }
+    // the readers go front to back once, let the kernel read ahead and
+    // drop the pages behind them
+    madvise(view, size_t(st.st_size), MADV_SEQUENTIAL);
+    size = size_t(st.st_size);
+#endif
+    data = static_cast<const char *>(view);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (!data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapping_handle);
+    CloseHandle(file_handle);
+    mapping_handle = file_handle = nullptr;
+#else
+    munmap(const_cast<char *>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+SceneInput::~SceneInput() { Close(); }
+
+bool SceneInput::Open(const std::string &path, SceneInputMethod method)
+{
+    Close();
+
+    bool compressed = HasSuffix(path, ".gz") || HasSuffix(path, ".zst");
+    if (method == SceneInputMethod::Auto && compressed) {
+        return OpenCompressed(path);
+    }
+    if (method != SceneInputMethod::Buffered && OpenMapped(path)) {
+        return true;
+    }
+    return OpenBuffered(path);
+}
+
+void SceneInput::Close()
+{
+    // a mapped stream reads the mapping
+    if (stream) {
+        std::fclose(stream);
+        stream = nullptr;
+    }
+    mapping.Close();
+
+    compressed_consumed.reset();
+    mapped_consumed.reset();
+    file_size = 0;
+}
+
+bool SceneInput::OpenMapped(const std::string &path)
+{
+    if (!mapping.Open(path)) {
+        return false;
+    }
+    file_size = mapping.Size();
+
+    auto counter = std::make_shared<std::atomic<size_t>>(0);
+    auto mapped = new MappedStream;
+    mapped->data = mapping.Data();
+    mapped->size = mapping.Size();
+    mapped->consumed = counter;
+    stream = OpenMappedStream(mapped);
+    if (stream) {
+        mapped_consumed = counter;
+    }
+    return true;
+}
+
+bool SceneInput::OpenBuffered(const std::string &path)
+{
+    stream = std::fopen(path.c_str(), "rb");
+    if (!stream) {
+        SPDLOG_ERROR("failed to open {}", path);
+        return false;
+    }
+    std::fseek(stream, 0, SEEK_END);
+    file_size = size_t(std::max(0L, std::ftell(stream)));
+    std::fseek(stream, 0, SEEK_SET);
+    return true;
+}
+
+bool SceneInput::OpenCompressed(const std::string &path)
+{
+    auto counter = std::make_shared<std::atomic<size_t>>(0);
+    std::unique_ptr<Decompressor> decompressor;
+
+    if (HasSuffix(path, ".gz")) {
+#ifdef COINAPP_WITH_ZLIB
+        gzFile gz = gzopen(path.c_str(), "rb");
+        if (gz) {
+            decompressor = std::make_unique<GzipDecompressor>(gz, counter);
+        }
+#else
+        // coin inflates gzip files itself when it finds zlib at runtime
+        return OpenBuffered(path);
+#endif
+    } else {
+#ifdef COINAPP_WITH_ZSTD
+        FILE *fp = std::fopen(path.c_str(), "rb");
+        if (fp) {
+            decompressor = std::make_unique<ZstdDecompressor>(fp, counter);
+        }
+#else
+        SPDLOG_ERROR("built without zstd, cannot read {}", path);
+        return false;
+#endif
+    }
+
+    if (!decompressor) {
+        SPDLOG_ERROR("failed to open {}", path);
+        return false;
+    }
+
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    file_size = ec ? 0 : size_t(size);
+
+    auto chunks = new ChunkStream;
+    chunks->decompressor = std::move(decompressor);
+    stream = OpenChunkStream(chunks);
+    if (!stream) {
+        SPDLOG_ERROR("failed to decompress {}", path);
+        return false;
+    }
+    compressed_consumed = counter;
+    return true;
+}
+
+void SceneInput::Attach(SoInput &input) const
+{
+    if (stream) {
+        input.setFilePointer(stream);
+    } else if (mapping.IsOpen()) {
+        input.setBuffer(mapping.Data(), mapping.Size());
+    }
+}
+
+const char *SceneInput::GetMethodName() const
+{
+    if (mapping.IsOpen()) {
+        return "mapped";
+    }
+    if (compressed_consumed) {
+        return "decompressed";
+    }
+    return stream ? "buffered" : "closed";
+}
+
+float SceneInput::GetProgress() const
+{
+    if (file_size == 0) {
+        return 0.f;
+    }
+    // the counters are written by the parser thread
+    auto &consumed = mapped_consumed ? mapped_consumed : compressed_consumed;
+    if (consumed) {
+        return std::clamp(float(consumed->load()) / float(file_size), 0.f,
+                          1.f);
+    }
+    if (mapping.IsOpen()) {
+        // the parser walks the buffer without telling anybody
+        return -1.f;
+    }
+    if (stream) {
+        // stdio locks the stream, ftell is safe while the parser reads it
+        return std::clamp(float(std::ftell(stream)) / float(file_size), 0.f,
+                          1.f);
+    }
+    return 0.f;
+}
+
+SoSeparator *ReadScene(const std::string &path, SceneInputMethod method)
+{
+    SceneInput scene_input;
+    if (!scene_input.Open(path, method)) {
+        return nullptr;
+    }
+
+    SoInput input;
+    scene_input.Attach(input);
+    SoSeparator *root = SoDB::readAll(&input);
+    input.closeFile();
+    return root;
+}
+
+} // namespace zen
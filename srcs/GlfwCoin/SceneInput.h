@@ -0,0 +1,99 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SceneInput.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:38:06, October 17, 2026
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+class SoInput;
+class SoSeparator;
+
+namespace zen
+{
+
+enum class SceneInputMethod {
+    Auto,     ///< decompress .gz/.zst, map everything else
+    Mapped,   ///< map the file and read it in place, falls back to Buffered
+    Buffered, ///< plain stdio
+};
+
+/// read-only mapping of a whole file
+class MappedFile
+{
+  public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile() { Close(); }
+
+    bool Open(const std::string &path);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const char *Data() const { return data; }
+    size_t Size() const { return size; }
+
+  private:
+    const char *data{nullptr};
+    size_t size{0};
+#ifdef _WIN32
+    void *file_handle{nullptr};
+    void *mapping_handle{nullptr};
+#endif
+};
+
+/// source of an inventor file for SoInput. Plain files are memory mapped and
+/// read in place through a stream counting the bytes consumed, .gz and .zst
+/// files are decompressed chunk by chunk while the parser reads them.
+class SceneInput
+{
+  public:
+    SceneInput() = default;
+    SceneInput(const SceneInput &) = delete;
+    SceneInput &operator=(const SceneInput &) = delete;
+    ~SceneInput();
+
+    bool Open(const std::string &path,
+              SceneInputMethod method = SceneInputMethod::Auto);
+    void Close();
+
+    /// the data stays valid until Close, close the SoInput first
+    void Attach(SoInput &input) const;
+
+    const char *GetMethodName() const;
+    size_t GetFileSize() const { return file_size; }
+    /// fraction of the file consumed by the parser, negative if unknown.
+    /// Safe to call from another thread while the parser runs.
+    float GetProgress() const;
+
+  private:
+    bool OpenMapped(const std::string &path);
+    bool OpenBuffered(const std::string &path);
+    bool OpenCompressed(const std::string &path);
+
+    size_t file_size{0};
+
+    MappedFile mapping;
+
+    // buffered or decompressed
+    FILE *stream{nullptr};
+    std::shared_ptr<std::atomic<size_t>> compressed_consumed;
+    // bytes of the mapping read, null where the mapping goes in as a buffer
+    std::shared_ptr<std::atomic<size_t>> mapped_consumed;
+};
+
+/// read a whole scene through SceneInput, null on failure. Like
+/// SoDB::readAll the returned root is not referenced.
+SoSeparator *ReadScene(const std::string &path,
+                       SceneInputMethod method = SceneInputMethod::Auto);
+
+} // namespace zen
@@ -0,0 +1,168 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SceneLoader.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:33:37, October 17, 2026
+ */
+#include "SceneLoader.h"
+#include "SceneCache.h"
+#include "SceneInput.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/SoInput.h>
+#include <Inventor/nodes/SoSeparator.h>
+
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+namespace zen
+{
+namespace
+{
+SoSeparator *AsSeparator(SoNode *node)
+{
+    if (!node || node->isOfType(SoSeparator::getClassTypeId())) {
+        return static_cast<SoSeparator *>(node);
+    }
+    auto separator = new SoSeparator;
+    separator->addChild(node);
+    return separator;
+}
+} // namespace
+
+SceneLoader::~SceneLoader()
+{
+    if (worker.joinable()) {
+        worker.join();
+    }
+    if (result) {
+        result->unref();
+    }
+}
+
+bool SceneLoader::Start(const std::string &file_path)
+{
+    if (IsLoading()) {
+        SPDLOG_WARN("already loading {}", path);
+        return false;
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+    if (result) {
+        result->unref();
+        result = nullptr;
+    }
+
+    path = file_path;
+    state = State::Loading;
+    if (!IsAsynchronous()) {
+        SPDLOG_INFO("coin is not thread safe, loading {} on this thread",
+                    path);
+        Load(cache_directory);
+        return true;
+    }
+    worker = std::thread(&SceneLoader::Load, this, cache_directory);
+    return true;
+}
+
+bool SceneLoader::IsAsynchronous()
+{
+    return SoDB::isMultiThread();
+}
+
+float SceneLoader::GetProgress() const
+{
+    if (GetState() != State::Loading) {
+        return GetState() == State::Finished ? 1.f : 0.f;
+    }
+
+    std::lock_guard lock(input_mutex);
+    return input ? input->GetProgress() : 0.f;
+}
+
+SoSeparator *SceneLoader::TakeResult()
+{
+    auto current = GetState();
+    if (current != State::Finished && current != State::Failed) {
+        return nullptr;
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    state = State::Idle;
+    return std::exchange(result, nullptr);
+}
+
+void SceneLoader::Load(const std::string &cache_dir)
+{
+    SoSeparator *root = nullptr;
+    uint64_t key = cache_dir.empty() ? 0 : SceneFileKey(path);
+    std::string cache_path = key ? SceneCachePath(cache_dir, key) : "";
+    // the source is only hashed to confirm a candidate, or for a new cache
+    uint64_t hash = 0;
+    std::error_code ec;
+    if (key && std::filesystem::exists(cache_path, ec)) {
+        hash = HashSceneFile(path);
+        root = hash ? AsSeparator(ReadSceneCache(cache_path, hash)) : nullptr;
+        if (root) {
+            root->ref();
+            SPDLOG_INFO("{} loaded from the scene cache", path);
+        }
+    }
+
+    if (!root) {
+        root = Parse();
+        if (root && key && !hash) {
+            hash = HashSceneFile(path);
+        }
+        // still unreachable from the live graph, nothing modifies it
+        if (root && hash) {
+            WriteSceneCache(root, cache_path, hash);
+        }
+    }
+
+    if (root) {
+        result = root;
+        state = State::Finished;
+    } else {
+        SPDLOG_ERROR("failed to read scene {}", path);
+        state = State::Failed;
+    }
+
+    if (on_finished) {
+        on_finished();
+    }
+}
+
+SoSeparator *SceneLoader::Parse()
+{
+    SceneInput scene_input;
+    if (!scene_input.Open(path)) {
+        return nullptr;
+    }
+    {
+        std::lock_guard lock(input_mutex);
+        input = &scene_input;
+    }
+
+    SoInput so_input;
+    scene_input.Attach(so_input);
+    SoSeparator *root = SoDB::readAll(&so_input);
+    if (root) {
+        root->ref();
+    }
+    so_input.closeFile();
+
+    std::lock_guard lock(input_mutex);
+    input = nullptr;
+    return root;
+}
+
+} // namespace zen
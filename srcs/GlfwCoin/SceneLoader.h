@@ -0,0 +1,83 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SceneLoader.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 12:33:37, October 17, 2026
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class SoSeparator;
+
+namespace zen
+{
+class SceneInput;
+
+/// parses an inventor/vrml file on a worker thread. The nodes are created off
+/// the render thread but stay unreachable from the live scene graph until
+/// the render thread takes the result between two frames.
+///
+/// Being unreachable is not enough on its own. Reading and writing a scene
+/// goes through global coin state the render thread uses as well: the name
+/// dictionaries of SoInput and SoBase, the type and node id counters and the
+/// reference counts. Only a coin built with COIN_THREADSAFE guards those,
+/// and that is off by default. Without it Start loads the file on the
+/// calling thread and returns with the state Finished or Failed.
+class SceneLoader
+{
+  public:
+    enum class State {
+        Idle,
+        Loading,
+        Finished,
+        Failed,
+    };
+
+    ~SceneLoader();
+
+    bool Start(const std::string &path);
+    /// false if coin is not thread safe and Start blocks until the file is
+    /// loaded
+    static bool IsAsynchronous();
+    State GetState() const { return state.load(); }
+    bool IsLoading() const { return GetState() == State::Loading; }
+    /// fraction of the file bytes consumed by the parser, negative while it
+    /// reads a mapped file
+    float GetProgress() const;
+    const std::string &GetPath() const { return path; }
+
+    /// the referenced root once the state is Finished, null otherwise. The
+    /// caller owns the reference, the loader goes back to Idle once a load
+    /// finished or failed.
+    SoSeparator *TakeResult();
+
+    /// called from the worker when the state left Loading
+    std::function<void()> on_finished;
+    /// binary caches of parsed files are looked up and stored here, keyed by
+    /// the file hash. Empty disables the cache, changes apply to the next
+    /// Start.
+    std::string cache_directory;
+
+  private:
+    void Load(const std::string &cache_dir);
+    SoSeparator *Parse();
+
+    std::thread worker;
+    std::atomic<State> state{State::Idle};
+    std::string path;
+
+    mutable std::mutex input_mutex;
+    const SceneInput *input{nullptr};
+
+    SoSeparator *result{nullptr};
+};
+
+} // namespace zen
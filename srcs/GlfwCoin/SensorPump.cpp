@@ -0,0 +1,61 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SensorPump.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:17:32, October 17, 2026
+ */
+#include "SensorPump.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/sensors/SoSensorManager.h>
+
+#include <chrono>
+
+namespace zen
+{
+void SensorPump::Process(bool budgeted)
+{
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto deadline =
+        start + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double, std::milli>(budget_ms));
+    bool limited = budgeted && budget_ms > 0.0;
+
+    stats.Reset();
+    auto manager = SoDB::getSensorManager();
+
+    manager->processTimerQueue();
+    // everything but the idle sensors
+    manager->processDelayQueue(FALSE);
+    stats.queue_passes += 2;
+    stats.unbudgeted_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+
+    int rounds = 0;
+    while (rounds < max_rounds && manager->isDelaySensorPending()) {
+        if (limited && Clock::now() >= deadline) {
+            if (rounds > 0 || deferred_frames < max_deferred_frames) {
+                stats.over_budget = true;
+                ++over_budget_frames;
+                break;
+            }
+            ++starved_frames;
+        }
+        manager->processDelayQueue(TRUE);
+        ++stats.queue_passes;
+        ++rounds;
+    }
+
+    stats.pending = manager->isDelaySensorPending();
+    // a pass ran, whatever is left got scheduled since
+    deferred_frames = rounds == 0 && stats.pending ? deferred_frames + 1 : 0;
+    stats.milliseconds =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+}
+
+} // namespace zen
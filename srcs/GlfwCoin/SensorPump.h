@@ -0,0 +1,68 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file SensorPump.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:17:32, October 17, 2026
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace zen
+{
+
+/// processes the coin sensor queues once per drawn frame, the idle part
+/// within a time budget. Coin only processes a queue as a whole, so the
+/// budget is checked between passes: the due timers, the delay queue without
+/// the idle sensors, then whole delay queue passes for the idle sensors and
+/// for the sensors the previous passes scheduled. What is left stays queued
+/// for the next frame. The first two passes always run, field and node
+/// sensors drive the redraws. Idle work deferred for max_deferred_frames
+/// frames in a row gets one pass regardless of the budget.
+///
+/// The budget cannot bound those first two passes, coin gives no control
+/// back inside a pass. Field sensor and engine bursts run there unbounded,
+/// the budget only covers idle sensors and what the first two passes
+/// scheduled. A pass only triggers the sensors queued when it starts, so
+/// the unbounded part is one callback per due timer and per scheduled
+/// non-idle sensor. Those callbacks are expected to stay cheap: set a flag,
+/// request a redraw or schedule an idle sensor for the heavy part, like
+/// DraggerAutoScaler does. Work that must not wait for the budget goes into
+/// a one shot sensor instead, like the drag step of DraggerMotionCoalescer.
+///
+/// Coin does not report how many sensors a pass triggered, the statistics
+/// count passes and time.
+class SensorPump
+{
+  public:
+    struct Stats {
+        size_t queue_passes{0}; ///< timer and delay queue passes
+        bool over_budget{false}; ///< idle passes left for the next frame
+        double milliseconds{0.0};
+        double unbudgeted_ms{0.0}; ///< of the passes that always run
+        bool pending{false}; ///< carried over to the next frame
+
+        void Reset() { *this = Stats{}; }
+    };
+
+    /// budgeted is false for frames that must see every pending sensor, like
+    /// RenderToBuffer
+    void Process(bool budgeted = true);
+
+    double budget_ms{8.0}; ///< 0 disables the budget
+    int max_deferred_frames{8};
+    /// passes over the delay queue per frame, sensors rescheduling themselves
+    /// would keep it busy forever
+    int max_rounds{4};
+
+    Stats stats; ///< of the last Process
+    size_t over_budget_frames{0}; ///< frames the budget cut short so far
+    size_t starved_frames{0}; ///< frames the budget was ignored so far
+
+  private:
+    int deferred_frames{0};
+};
+
+} // namespace zen
@@ -0,0 +1,95 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file StaticLayer.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:13:21, October 17, 2026
+ */
+#include "StaticLayer.h"
+
+#include <Inventor/nodes/SoNode.h>
+
+#include <spdlog/spdlog.h>
+
+#ifndef GL_FRAMEBUFFER_EXT
+#define GL_FRAMEBUFFER_EXT 0x8D40
+#endif
+
+namespace zen
+{
+StaticLayer::StaticLayer() : sensor(SensorCallback, this)
+{
+    // immediate, the callback only sets a flag
+    sensor.setPriority(0);
+}
+
+StaticLayer::~StaticLayer()
+{
+    sensor.detach();
+    Release();
+}
+
+void StaticLayer::SetSceneGraph(SoNode *root)
+{
+    sensor.detach();
+    if (root) {
+        sensor.attach(root);
+    }
+    dirty = true;
+}
+
+bool StaticLayer::Draw(const cc_glglue *glue, int width, int height,
+                       GLuint framebuffer, GLenum depth_format,
+                       const std::function<void()> &render)
+{
+    if (unsupported || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    if (glue != target.glue || width != target.width ||
+        height != target.height || depth_format != target.depth_format) {
+        target.Destroy();
+        target.depth_format = depth_format;
+        if (!target.Resize(glue, width, height)) {
+            unsupported = true;
+            return false;
+        }
+        dirty = true;
+    }
+
+    if (dirty) {
+        // cleared first, a scene that notifies while it renders is never
+        // reused
+        dirty = false;
+        target.Bind();
+        render();
+        ++renders;
+    } else {
+        ++reuses;
+    }
+
+    if (!target.BlitTo(framebuffer, width, height,
+                       GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT,
+                       GL_NEAREST)) {
+        SPDLOG_WARN("cannot copy the cached scene, rendering it every frame");
+        cc_glglue_glBindFramebuffer(glue, GL_FRAMEBUFFER_EXT, framebuffer);
+        unsupported = true;
+        Release();
+        return false;
+    }
+    return true;
+}
+
+void StaticLayer::Release()
+{
+    target.Destroy();
+    dirty = true;
+}
+
+void StaticLayer::SensorCallback(void *user, SoSensor *)
+{
+    static_cast<StaticLayer *>(user)->dirty = true;
+}
+
+} // namespace zen
@@ -0,0 +1,60 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file StaticLayer.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:13:21, October 17, 2026
+ */
+#pragma once
+
+#include "OffscreenTarget.h"
+
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <cstddef>
+#include <functional>
+
+class SoNode;
+
+namespace zen
+{
+
+/// color and depth of a scene graph rendered once into a framebuffer and
+/// copied into the frame as long as nothing below the root notified and the
+/// size did not change. The camera has to be part of the graph, so moving it
+/// invalidates the image as well.
+class StaticLayer
+{
+  public:
+    StaticLayer();
+    ~StaticLayer();
+
+    void SetSceneGraph(SoNode *root);
+    void Invalidate() { dirty = true; }
+    bool IsDirty() const { return dirty; }
+
+    /// renders through render into the cached image if it is stale, then
+    /// blits color and depth into framebuffer. depth_format is the one of the
+    /// depth buffer of framebuffer, blitting depth needs matching formats.
+    /// Returns false without touching framebuffer when the image cannot be
+    /// used, the caller renders the scene itself then.
+    bool Draw(const cc_glglue *glue, int width, int height,
+              GLuint framebuffer, GLenum depth_format,
+              const std::function<void()> &render);
+    void Release();
+
+    size_t renders{0}; ///< frames the image was rendered again
+    size_t reuses{0};  ///< frames the image was only copied
+
+  private:
+    static void SensorCallback(void *user, SoSensor *sensor);
+
+    SoNodeSensor sensor;
+    OffscreenTarget target;
+    bool dirty{true};
+    // the blit failed once, e.g. on a multisampled window, never retried
+    bool unsupported{false};
+};
+
+} // namespace zen
@@ -0,0 +1,132 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file UiHooks.cpp
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:10:58, October 17, 2026
+ */
+#include "UiHooks.h"
+
+#include <Inventor/nodes/SoNode.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace zen
+{
+UiHookRegistry::~UiHookRegistry()
+{
+    for (auto list : {&entries, &added}) {
+        for (auto &entry : *list) {
+            Drop(entry);
+        }
+    }
+}
+
+size_t UiHookRegistry::Add(SoNode *node, Hook hook)
+{
+    if (!node || !hook) {
+        return 0;
+    }
+
+    Compact();
+
+    Entry entry;
+    entry.id = next_id++;
+    entry.node = node;
+    entry.hook = std::move(hook);
+    // only watches for the destruction of the node, immediate so field
+    // changes never go through the delay queue
+    entry.sensor = std::make_unique<SoNodeSensor>(NodeChanged, nullptr);
+    entry.sensor->setPriority(0);
+    entry.sensor->setDeleteCallback(NodeDeleted, this);
+    entry.sensor->attach(node);
+    size_t id = entry.id;
+    // growing entries would move the hook that is running
+    (drawing ? added : entries).push_back(std::move(entry));
+    return id;
+}
+
+void UiHookRegistry::Remove(size_t id)
+{
+    for (auto list : {&entries, &added}) {
+        for (auto &entry : *list) {
+            if (entry.id == id) {
+                Drop(entry);
+            }
+        }
+    }
+    Compact();
+}
+
+void UiHookRegistry::RemoveNode(SoNode *node)
+{
+    for (auto list : {&entries, &added}) {
+        for (auto &entry : *list) {
+            if (entry.node == node) {
+                Drop(entry);
+            }
+        }
+    }
+    Compact();
+}
+
+void UiHookRegistry::Draw()
+{
+    drawing = true;
+    for (auto &entry : entries) {
+        if (entry.node) {
+            entry.hook();
+        }
+    }
+    drawing = false;
+
+    // hooks added meanwhile start next frame
+    std::move(added.begin(), added.end(), std::back_inserter(entries));
+    added.clear();
+    Compact();
+}
+
+size_t UiHookRegistry::Size() const
+{
+    auto alive = [](const Entry &e) { return e.node != nullptr; };
+    return size_t(std::count_if(entries.begin(), entries.end(), alive) +
+                  std::count_if(added.begin(), added.end(), alive));
+}
+
+void UiHookRegistry::NodeChanged(void *, SoSensor *) {}
+
+void UiHookRegistry::NodeDeleted(void *user, SoSensor *sensor)
+{
+    auto self = static_cast<UiHookRegistry *>(user);
+    for (auto list : {&self->entries, &self->added}) {
+        for (auto &entry : *list) {
+            if (entry.sensor.get() == sensor) {
+                // coin detaches the sensor itself, the entry goes with the
+                // next Compact as the sensor is still in use here
+                entry.node = nullptr;
+            }
+        }
+    }
+}
+
+void UiHookRegistry::Drop(Entry &entry)
+{
+    if (entry.node) {
+        entry.sensor->detach();
+        entry.node = nullptr;
+    }
+}
+
+void UiHookRegistry::Compact()
+{
+    // the hook being called and the sensor being triggered must survive
+    // until Draw returns
+    if (drawing) {
+        return;
+    }
+    std::erase_if(entries, [](const Entry &e) { return !e.node; });
+}
+
+} // namespace zen
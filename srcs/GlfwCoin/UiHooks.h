@@ -0,0 +1,66 @@
+/**
+ * Copyright © 2025 Zen Shawn. All rights reserved.
+ *
+ * @file UiHooks.h
+ * @author Zen Shawn
+ * @email xiaozisheng2008@hotmail.com
+ * @date 13:10:58, October 17, 2026
+ */
+#pragma once
+
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class SoNode;
+
+namespace zen
+{
+
+/// imgui drawing attached to scene graph nodes. The hooks run once per frame
+/// inside the imgui frame but outside of any coin traversal, so a panel does
+/// not need a SoCallback in the scene that invalidates the render caches up
+/// to the root. A hook is dropped when its node gets destroyed, the registry
+/// does not reference the nodes.
+class UiHookRegistry
+{
+  public:
+    using Hook = std::function<void()>;
+
+    ~UiHookRegistry();
+
+    /// returns an id for Remove, never 0
+    size_t Add(SoNode *node, Hook hook);
+    void Remove(size_t id);
+    /// drops every hook of node
+    void RemoveNode(SoNode *node);
+
+    /// calls the hooks in the order they were added, hooks may add or remove
+    /// hooks and destroy nodes
+    void Draw();
+
+    size_t Size() const;
+
+  private:
+    struct Entry {
+        size_t id{0};
+        SoNode *node{nullptr}; // null once removed
+        Hook hook;
+        std::unique_ptr<SoNodeSensor> sensor;
+    };
+
+    static void NodeChanged(void *user, SoSensor *sensor);
+    static void NodeDeleted(void *user, SoSensor *sensor);
+    void Drop(Entry &entry);
+    void Compact();
+
+    std::vector<Entry> entries;
+    std::vector<Entry> added; // by hooks while Draw runs
+    size_t next_id{1};
+    bool drawing{false};
+};
+
+} // namespace zen
@@ -8,8 +8,15 @@
  */
 #pragma once
 
+#include <Inventor/SbRotation.h>
+#include <Inventor/SbVec3f.h>
+
+#include <cstddef>
 #include <functional>
+#include <string>
+#include <vector>
 
+class SoMFVec3f;
 class SoNode;
 class SoTransform;
 
@@ -17,19 +24,123 @@ namespace zen
 {
 struct CoinAppImpl;
 
+enum class RenderMode {
+    Continuous, ///< redraw on every loop iteration
+    OnDemand,   ///< sleep until input, a due sensor or a scene change
+};
+
+enum class Backend {
+    Window,    ///< glfw window with imgui, driven by Run
+    Offscreen, ///< no display server, render through RenderToBuffer
+};
+
+enum class QualityMode {
+    Full,       ///< always render at full quality
+    Complexity, ///< lower the SoComplexity value while interacting
+    Resolution, ///< render into a scaled down target while interacting
+};
+
+struct CommandQueueStats {
+    size_t depth{0};      ///< commands waiting for the next drain
+    size_t peak_depth{0}; ///< since the app was created
+    size_t drained{0};    ///< commands applied by the last drain
+    size_t touched{0};    ///< nodes notified by the last drain
+    double drain_ms{0.0}; ///< time of the last drain
+};
+
+struct ReplayOptions {
+    bool realtime{true}; ///< false feeds the recorded frames as fast as possible
+    bool close_when_done{false};
+    std::string timings_file; ///< per-frame timings as json, optional
+};
+
 class CoinApp
 {
   public:
-    CoinApp(const char *title = "ZenView");
+    CoinApp(const char *title = "ZenView", Backend backend = Backend::Window);
 
     ~CoinApp();
 
     void SetSceneGraph(SoNode *scene);
+    /// read an inventor/vrml file on a worker thread and swap it in as the
+    /// scene graph between two frames once parsed, Run keeps drawing the
+    /// current scene with a progress bar meanwhile. Needs a coin built
+    /// thread safe, otherwise the file is read before this returns.
+    bool LoadSceneAsync(const std::string &path);
+    /// LoadSceneAsync keeps binary caches of the parsed files here and skips
+    /// the parsing when the file content did not change. Defaults to a
+    /// folder in the temp directory, empty disables the cache.
+    void SetSceneCacheDirectory(const std::string &directory);
     void SetImGuiCallback(std::function<void()> callback);
+    /// draw imgui widgets for node once per frame. The hook runs outside the
+    /// scene graph traversal, so the render caches survive the UI redraws,
+    /// and is dropped once node gets destroyed. Returns an id for
+    /// RemoveUiHook.
+    size_t AddUiHook(SoNode *node, std::function<void()> hook);
+    void RemoveUiHook(size_t id);
     void SetGizmoTransform(SoTransform *transform);
 
+    /// nodes that change during interaction, like draggers, highlights or
+    /// annotations. While there are any, the scene graph is rendered into a
+    /// cached color and depth image that is reused until the scene, the
+    /// camera or the viewport change, and the layers are rendered on top of
+    /// it every frame. The layers share the light and the camera of the
+    /// scene but nothing else of it, and get the events like the scene.
+    void AddDynamicLayer(SoNode *layer);
+    void RemoveDynamicLayer(SoNode *layer);
+    /// reuse the image of the scene while dynamic layers exist, on by default
+    void SetStaticLayerCaching(bool enable);
+
+    void SetRenderMode(RenderMode mode);
+    /// cap the redraw rate, 0 means uncapped
+    void SetMaxFrameRate(double fps);
+    /// time per drawn frame for the idle coin sensors and what the other
+    /// sensors scheduled, the work left over is carried to the next frame.
+    /// Timers and the other delay sensors always run. 0 processes every
+    /// pending sensor each frame.
+    void SetSensorBudget(double milliseconds);
+    /// schedule a redraw for the on-demand mode
+    void RequestRedraw();
+
+    /// trade quality for frame rate while the user navigates or drags, the
+    /// scale follows the frame time towards budget_ms. One frame at full
+    /// quality is drawn once the input went idle. Complexity only affects
+    /// the shapes without a SoComplexity node of their own.
+    void SetAdaptiveQuality(QualityMode mode, double budget_ms = 33.3);
+
+    /// toggle the frame timing overlay, F3 toggles it at runtime
+    void ShowFrameTimings(bool show);
+    /// per-phase timings of the last frames as json, in milliseconds
+    std::string DumpFrameTimings(size_t frames = 240) const;
+
+    /// record the glfw input of the following frames into a binary log
+    bool StartRecording(const std::string &path);
+    void StopRecording();
+    /// feed a recorded log through the glfw callbacks, live input is ignored
+    /// until the replay finished
+    bool StartReplay(const std::string &path,
+                     const ReplayOptions &options = {});
+    bool IsReplaying() const;
+
+    /// thread safe, the commands are applied on the render thread before the
+    /// sensors of the next frame, in one notification batch. The nodes and
+    /// fields must stay alive until then, they are not referenced.
+    void Post(std::function<void()> command);
+    void PostTranslation(SoTransform *transform, const SbVec3f &translation);
+    void PostRotation(SoTransform *transform, const SbRotation &rotation);
+    /// replaces all values of field
+    void PostValues(SoMFVec3f *field, std::vector<SbVec3f> values);
+    CommandQueueStats GetCommandQueueStats() const;
+
     void Run();
 
+    /// render the scene graph into caller-provided buffers of width x height
+    /// pixels, rows are stored bottom-up as returned by glReadPixels.
+    /// @param rgba 4 * width * height bytes, may be null
+    /// @param depth width * height floats in [0, 1], may be null
+    bool RenderToBuffer(int width, int height, unsigned char *rgba,
+                        float *depth = nullptr);
+
   private:
     CoinAppImpl *impl;
 };